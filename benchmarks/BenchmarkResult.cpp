@@ -26,7 +26,18 @@ std::ostream& operator<<(std::ostream& out, const BenchmarkResult& result)
         << "\nAvr. No. Retries during Find: "
         << std::to_string(result.averageNumberOfRetriesDuringFind)
         << "\nFind throughput: " << std::to_string(result.findThroughput)
-        << " Ops/s";
+        << " Ops/s"
+        << "\nReclaimed nodes: "
+        << std::to_string(result.numberOfReclaimedNodes)
+        << "\nReclaimed memory: " << std::to_string(result.reclaimedMemory)
+        << " bytes"
+        << "\nLock acquisitions: "
+        << std::to_string(result.numberOfLockAcquisitions)
+        << "\nMin. thread throughput: "
+        << std::to_string(result.minimumThreadThroughput) << " Ops/s"
+        << "\nMax. thread throughput: "
+        << std::to_string(result.maximumThreadThroughput) << " Ops/s"
+        << "\nFairness: " << std::to_string(result.fairness);
 
     return out;
 }
@@ -18,6 +18,12 @@ struct BenchmarkResult {
     std::size_t numberOfFinds;
     double averageNumberOfRetriesDuringFind;
     double findThroughput; // per s
+    std::size_t numberOfReclaimedNodes;
+    std::size_t reclaimedMemory; // bytes
+    std::size_t numberOfLockAcquisitions;
+    double minimumThreadThroughput; // per s
+    double maximumThreadThroughput; // per s
+    double fairness; // Jain's index of the thread throughputs, 1 is fair
 };
 
 std::ostream& operator<<(std::ostream& out, const BenchmarkResult& result);
@@ -1,9 +1,11 @@
 #include "Benchmarking.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <mutex>
+#include <numeric>
 
 #include <boost/thread/barrier.hpp>
 
@@ -22,6 +24,7 @@ BenchmarkData runBenchmark(const BenchmarkConfiguration& config)
         std::uint16_t repetition;
         std::chrono::nanoseconds duration;
         SkipListStatistics statistics;
+        std::vector<double> threadThroughputs; // per s
     };
     std::vector<RepetitionData> repData(config.repetitions);
 
@@ -30,6 +33,7 @@ BenchmarkData runBenchmark(const BenchmarkConfiguration& config)
     Thread::parallel(
         [&] {
             Timer<std::chrono::high_resolution_clock> timer;
+            Timer<std::chrono::high_resolution_clock> threadTimer;
 
             for (std::uint16_t i = 0; i < config.repetitions; i++) {
                 RepetitionData& data = repData[i];
@@ -41,9 +45,12 @@ BenchmarkData runBenchmark(const BenchmarkConfiguration& config)
 
                 barrier.wait();
                 timer.start();
+                threadTimer.start();
 
                 workStrategy.work(config, *list);
 
+                threadTimer.stop();
+
                 barrier.wait();
                 timer.stop();
 
@@ -54,8 +61,15 @@ BenchmarkData runBenchmark(const BenchmarkConfiguration& config)
 
                 // merge the collected performance statistics of each thread
                 Thread::critical([&] {
-                    SkipListStatistics::threadLocalInstance().mergeInto(
-                        data.statistics);
+                    auto& statistics =
+                        SkipListStatistics::threadLocalInstance();
+                    data.threadThroughputs.push_back(
+                        (statistics.numberOfInserts() +
+                         statistics.numberOfDeletions() +
+                         statistics.numberOfLookups()) /
+                        (threadTimer.elapsed().count() / 1000.0 / 1000.0 /
+                         1000.0));
+                    statistics.mergeInto(data.statistics);
                 });
 
                 workStrategy.cleanup(config, *list);
@@ -90,6 +104,25 @@ BenchmarkData runBenchmark(const BenchmarkConfiguration& config)
         result.averageNumberOfRetriesDuringFind =
             statistics.averageNumberOfRetriesDuringLookup();
         result.findThroughput = result.numberOfFinds / result.totalTime;
+        result.numberOfReclaimedNodes = statistics.numberOfReclaimedNodes();
+        result.reclaimedMemory = statistics.reclaimedMemory();
+        result.numberOfLockAcquisitions =
+            statistics.numberOfLockAcquisitions();
+
+        // every thread performs its share of the operations, so unfair locks
+        // show up as threads that take longer for the same number
+        const auto& throughputs = rep.threadThroughputs;
+        const auto minmax =
+            std::minmax_element(throughputs.begin(), throughputs.end());
+        result.minimumThreadThroughput = *minmax.first;
+        result.maximumThreadThroughput = *minmax.second;
+        const auto sum =
+            std::accumulate(throughputs.begin(), throughputs.end(), 0.0);
+        const auto sumOfSquares = std::inner_product(
+            throughputs.begin(), throughputs.end(), throughputs.begin(), 0.0);
+        result.fairness = sumOfSquares > 0
+                              ? sum * sum / (throughputs.size() * sumOfSquares)
+                              : 1.0;
 
         benchmarkData.results.push_back(result);
     }
@@ -143,6 +176,14 @@ static std::string currentDateTimeStr()
     return ss.str();
 }
 
+std::string csvFileName(const std::string& fileNamePrefix)
+{
+    char hostname[50];
+    gethostname(hostname, 50);
+    return fileNamePrefix + "_" + hostname + "_" + currentDateTimeStr() +
+           ".csv";
+}
+
 void saveBenchmarksAsCsv(const std::vector<BenchmarkData>& benchmarks,
                          const std::string& fileNamePrefix)
 {
@@ -173,13 +214,16 @@ void saveBenchmarksAsCsv(const std::vector<BenchmarkData>& benchmarks,
             << seperator << std::to_string(result.removeThroughput) << seperator
             << std::to_string(result.numberOfFinds) << seperator
             << std::to_string(result.averageNumberOfRetriesDuringFind)
-            << seperator << std::to_string(result.findThroughput) << seperator;
+            << seperator << std::to_string(result.findThroughput) << seperator
+            << std::to_string(result.numberOfReclaimedNodes) << seperator
+            << std::to_string(result.reclaimedMemory) << seperator
+            << std::to_string(result.numberOfLockAcquisitions) << seperator
+            << std::to_string(result.minimumThreadThroughput) << seperator
+            << std::to_string(result.maximumThreadThroughput) << seperator
+            << std::to_string(result.fairness) << seperator;
     };
 
-    char hostname[50];
-    gethostname(hostname, 50);
-    const auto fileName =
-        fileNamePrefix + "_" + hostname + "_" + currentDateTimeStr() + ".csv";
+    const auto fileName = csvFileName(fileNamePrefix);
 
     std::ofstream file(fileName, std::ofstream::trunc);
     for (const auto& benchmark : benchmarks) {
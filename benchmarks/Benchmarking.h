@@ -26,5 +26,10 @@ BenchmarkData runBenchmark(const BenchmarkConfiguration& config);
 std::vector<BenchmarkData>
 runBenchmarks(const std::vector<BenchmarkConfiguration>& configs);
 
+/**
+ * @return `<prefix>_<hostname>_<date>.csv`
+ */
+std::string csvFileName(const std::string& fileNamePrefix);
+
 void saveBenchmarksAsCsv(const std::vector<BenchmarkData>& benchmarks,
                          const std::string& fileNamePrefix);
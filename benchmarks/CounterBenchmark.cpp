@@ -0,0 +1,121 @@
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/thread/barrier.hpp>
+
+#include "Benchmarking.h"
+#include "ShardedCounter.h"
+#include "Thread.h"
+#include "Timer.h"
+
+/**
+ * Compares the size counter update throughput of a single shared atomic with
+ * the sharded counter. Every thread alternates between increments and
+ * decrements, like a mixed insert/remove workload does.
+ */
+
+struct CounterResult {
+    std::string counter;
+    std::size_t numberOfThreads;
+    std::uint16_t repetition;
+    double totalTime;
+    double throughput;
+};
+
+template <typename Counter>
+static std::vector<CounterResult>
+runCounterBenchmark(const std::string& name, std::size_t numberOfThreads,
+                    std::size_t numberOfUpdates, std::uint16_t repetitions)
+{
+    std::vector<CounterResult> results;
+
+    for (std::uint16_t repetition = 1; repetition <= repetitions;
+         ++repetition) {
+        Counter counter;
+        boost::barrier barrier(numberOfThreads);
+        Timer<std::chrono::high_resolution_clock> timer;
+
+        // strong scaling, the updates are distributed among all threads
+        const auto updatesPerThread = numberOfUpdates / numberOfThreads;
+        Thread::parallel(
+            [&] {
+                barrier.wait();
+                Thread::single([&] { timer.start(); });
+
+                for (std::size_t i = 0; i < updatesPerThread; ++i) {
+                    if (i % 2 == 0) {
+                        ++counter;
+                    } else {
+                        --counter;
+                    }
+                }
+
+                barrier.wait();
+                Thread::single([&] { timer.stop(); });
+            },
+            numberOfThreads);
+
+        CounterResult result;
+        result.counter = name;
+        result.numberOfThreads = numberOfThreads;
+        result.repetition = repetition;
+        result.totalTime =
+            timer.elapsed().count() / 1000.0 / 1000.0 / 1000.0;
+        result.throughput =
+            updatesPerThread * numberOfThreads / result.totalTime;
+        results.push_back(result);
+
+        std::cout << name << " - " << numberOfThreads << " threads - "
+                  << std::to_string(result.throughput) << " updates/s"
+                  << std::endl;
+    }
+
+    return results;
+}
+
+static void saveResultsAsCsv(const std::vector<CounterResult>& results,
+                             const std::string& fileNamePrefix)
+{
+    const auto seperator = ";";
+    const auto fileName = csvFileName(fileNamePrefix);
+
+    std::ofstream file(fileName, std::ofstream::trunc);
+    for (const auto& result : results) {
+        file << result.counter << seperator
+             << std::to_string(result.numberOfThreads) << seperator
+             << std::to_string(result.repetition) << seperator
+             << std::to_string(result.totalTime) << seperator
+             << std::to_string(result.throughput) << seperator << "\n";
+    }
+    file.close();
+
+    std::cout << "Saved benchmark results to `" << fileName << "`" << std::endl;
+}
+
+int main()
+{
+    const std::vector<std::size_t> threadCounts = {1,  2,  4,  8, 12,
+                                                   16, 24, 32, 40, 48};
+    const std::size_t numberOfUpdates = 4800000;
+    const std::uint16_t repetitions = 5;
+
+    std::vector<CounterResult> results;
+    for (auto threads : threadCounts) {
+        for (const auto& result : runCounterBenchmark<std::atomic_size_t>(
+                 "atomic", threads, numberOfUpdates, repetitions)) {
+            results.push_back(result);
+        }
+        for (const auto& result : runCounterBenchmark<ShardedCounter>(
+                 "sharded", threads, numberOfUpdates, repetitions)) {
+            results.push_back(result);
+        }
+    }
+
+    saveResultsAsCsv(results, "CounterBenchmark");
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/thread/barrier.hpp>
+
+#include "Benchmarking.h"
+#include "HeightGenerator.h"
+#include "LockFreeSkipList.h"
+#include "SequentialSkipList.h"
+#include "Thread.h"
+#include "Timer.h"
+
+/**
+ * Compares the insert throughput of the lists with different height
+ * generators, including the previous coin flip implementation.
+ */
+
+/**
+ * Previous implementation: std::random_device per call and one
+ * bernoulli_distribution coin flip per level.
+ */
+class LegacyHeightGenerator
+{
+  public:
+    template <std::uint16_t MaximumHeight>
+    static std::uint16_t generate()
+    {
+        std::random_device randomDevice;
+        static thread_local std::mt19937 generator(randomDevice());
+        std::bernoulli_distribution distribution(0.5);
+        const auto flipCoinAndCheckIfHead = [&] {
+            return distribution(generator) == true;
+        };
+
+        std::uint16_t height = 0;
+        while (not flipCoinAndCheckIfHead() and
+               (height < (MaximumHeight - 1))) {
+            ++height;
+        }
+        return height;
+    }
+};
+
+struct InsertResult {
+    std::string list;
+    std::string generator;
+    std::size_t numberOfThreads;
+    std::uint16_t repetition;
+    double totalTime;
+    double throughput;
+};
+
+template <typename List>
+static std::vector<InsertResult>
+runInsertBenchmark(const std::string& listName,
+                   const std::string& generatorName,
+                   std::size_t numberOfThreads, std::size_t numberOfItems,
+                   std::uint16_t repetitions)
+{
+    std::vector<long> values(numberOfItems);
+    std::iota(values.begin(), values.end(), 0);
+    std::shuffle(values.begin(), values.end(), std::mt19937(42));
+
+    std::vector<InsertResult> results;
+    for (std::uint16_t repetition = 1; repetition <= repetitions;
+         ++repetition) {
+        List list;
+        boost::barrier barrier(numberOfThreads);
+        Timer<std::chrono::high_resolution_clock> timer;
+
+        Thread::parallel(
+            [&] {
+                barrier.wait();
+                Thread::single([&] { timer.start(); });
+
+                // strong scaling, every thread inserts an interleaved part
+                for (std::size_t i = Thread::currentThreadId();
+                     i < numberOfItems; i += numberOfThreads) {
+                    list.insert(values[i]);
+                }
+
+                barrier.wait();
+                Thread::single([&] { timer.stop(); });
+            },
+            numberOfThreads);
+
+        InsertResult result;
+        result.list = listName;
+        result.generator = generatorName;
+        result.numberOfThreads = numberOfThreads;
+        result.repetition = repetition;
+        result.totalTime =
+            timer.elapsed().count() / 1000.0 / 1000.0 / 1000.0;
+        result.throughput = numberOfItems / result.totalTime;
+        results.push_back(result);
+
+        std::cout << listName << " - " << generatorName << " - "
+                  << numberOfThreads << " threads - "
+                  << std::to_string(result.throughput) << " inserts/s"
+                  << std::endl;
+    }
+
+    return results;
+}
+
+static void saveResultsAsCsv(const std::vector<InsertResult>& results,
+                             const std::string& fileNamePrefix)
+{
+    const auto seperator = ";";
+    const auto fileName = csvFileName(fileNamePrefix);
+
+    std::ofstream file(fileName, std::ofstream::trunc);
+    for (const auto& result : results) {
+        file << result.list << seperator << result.generator << seperator
+             << std::to_string(result.numberOfThreads) << seperator
+             << std::to_string(result.repetition) << seperator
+             << std::to_string(result.totalTime) << seperator
+             << std::to_string(result.throughput) << seperator << "\n";
+    }
+    file.close();
+
+    std::cout << "Saved benchmark results to `" << fileName << "`" << std::endl;
+}
+
+template <typename Generator>
+static void runBenchmarks(std::vector<InsertResult>& results,
+                          const std::string& generatorName)
+{
+    const std::vector<std::size_t> threadCounts = {1, 8, 48};
+    const std::size_t numberOfItems = 100000;
+    const std::uint16_t repetitions = 3;
+
+    for (const auto& result :
+         runInsertBenchmark<SequentialSkipList<long, 16, HeapNodeAllocator,
+                                               Generator>>(
+             "SequentialSkipList", generatorName, 1, numberOfItems,
+             repetitions)) {
+        results.push_back(result);
+    }
+
+    for (auto threads : threadCounts) {
+        for (const auto& result :
+             runInsertBenchmark<
+                 LockFreeSkipList<long, 16, EpochBasedReclamation,
+                                  HeapNodeAllocator, Generator>>(
+                 "LockFreeSkipList", generatorName, threads, numberOfItems,
+                 repetitions)) {
+            results.push_back(result);
+        }
+    }
+}
+
+int main()
+{
+    std::vector<InsertResult> results;
+    runBenchmarks<LegacyHeightGenerator>(results, "legacy 1/2");
+    runBenchmarks<HalfHeightGenerator>(results, "1/2");
+    runBenchmarks<QuarterHeightGenerator>(results, "1/4");
+    runBenchmarks<InverseEHeightGenerator>(results, "1/e");
+
+    saveResultsAsCsv(results, "HeightBenchmark");
+
+    return EXIT_SUCCESS;
+}
@@ -6,27 +6,120 @@
 
 #include "Benchmarking.h"
 #include "ConcurrentSkipList.h"
+#include "FlatCombiningSkipList.h"
 #include "LazySkipList.h"
 #include "LockFreeSkipList.h"
 #include "MMLazySkipList.h"
 #include "MMLockFreeSkipList.h"
+#include "NoHotSpotSkipList.h"
+#include "PartitionedSkipList.h"
 #include "SequentialSkipList.h"
+#include "UnrolledSkipList.h"
 #include "WorkStrategy.h"
 
-template <template <typename, std::uint16_t> class T,
-          std::uint16_t SkipListHeight>
-static void createBenchmarks(std::vector<BenchmarkConfiguration>& benchmarks,
-                             const std::vector<Scaling>& scalingModes,
-                             const std::vector<std::size_t>& threadCounts,
-                             const std::vector<std::size_t>& initialSizes)
+template <typename T, std::uint16_t MaximumHeight>
+using HazardPointerLockFreeSkipList =
+    LockFreeSkipList<T, MaximumHeight, HazardPointerReclamation>;
+
+template <typename T, std::uint16_t MaximumHeight>
+using LeakingLockFreeSkipList =
+    LockFreeSkipList<T, MaximumHeight, NoReclamation>;
+
+template <typename T, std::uint16_t MaximumHeight>
+using SlabLazySkipList =
+    LazySkipList<T, MaximumHeight, SlabNodeAllocator<>>;
+
+template <typename T, std::uint16_t MaximumHeight>
+using SlabLockFreeSkipList =
+    LockFreeSkipList<T, MaximumHeight, EpochBasedReclamation,
+                     SlabNodeAllocator<>>;
+
+template <typename T, std::uint16_t MaximumHeight>
+using HugePageLockFreeSkipList =
+    LockFreeSkipList<T, MaximumHeight, EpochBasedReclamation,
+                     SlabNodeAllocator<true>>;
+
+template <typename T, std::uint16_t MaximumHeight>
+using SharedConcurrentSkipList =
+    ConcurrentSkipList<T, MaximumHeight, SharedLocking>;
+
+template <typename T, std::uint16_t MaximumHeight>
+using RcuConcurrentSkipList = ConcurrentSkipList<T, MaximumHeight, RcuLocking>;
+
+template <typename T, std::uint16_t MaximumHeight>
+using TicketConcurrentSkipList =
+    ConcurrentSkipList<T, MaximumHeight, QueueLocking<TicketLock>>;
+
+template <typename T, std::uint16_t MaximumHeight>
+using MCSConcurrentSkipList =
+    ConcurrentSkipList<T, MaximumHeight, QueueLocking<MCSLock>>;
+
+template <typename T, std::uint16_t MaximumHeight>
+using CLHConcurrentSkipList =
+    ConcurrentSkipList<T, MaximumHeight, QueueLocking<CLHLock>>;
+
+template <typename T, std::uint16_t MaximumHeight>
+using DefaultUnrolledSkipList = UnrolledSkipList<T, MaximumHeight>;
+
+template <typename T, std::uint16_t MaximumHeight>
+using FingerSequentialSkipList =
+    SequentialSkipList<T, MaximumHeight, HeapNodeAllocator,
+                       HalfHeightGenerator, std::less<T>, ThreadFinger>;
+
+template <typename T, std::uint16_t MaximumHeight>
+using CachedKeySequentialSkipList =
+    SequentialSkipList<T, MaximumHeight, HeapNodeAllocator,
+                       HalfHeightGenerator, std::less<T>, NoFinger,
+                       ExclusiveAccess, CachedSuccessorKeys>;
+
+template <typename T, std::uint16_t MaximumHeight>
+using FingerLazySkipList =
+    LazySkipList<T, MaximumHeight, HeapNodeAllocator, HalfHeightGenerator,
+                 std::less<T>, ThreadFinger>;
+
+template <typename T, std::uint16_t MaximumHeight>
+using CachedKeyLazySkipList =
+    LazySkipList<T, MaximumHeight, HeapNodeAllocator, HalfHeightGenerator,
+                 std::less<T>, NoFinger, LockThenValidate,
+                 CachedSuccessorKeys>;
+
+template <typename T, std::uint16_t MaximumHeight>
+using PrefetchingLazySkipList =
+    LazySkipList<T, MaximumHeight, HeapNodeAllocator, HalfHeightGenerator,
+                 std::less<T>, NoFinger, LockThenValidate, NoSuccessorKeys,
+                 SuccessorPrefetching>;
+
+template <typename T, std::uint16_t MaximumHeight>
+using OptimisticLazySkipList =
+    LazySkipList<T, MaximumHeight, HeapNodeAllocator, HalfHeightGenerator,
+                 std::less<T>, NoFinger, OptimisticValidation>;
+
+template <typename T, std::uint16_t MaximumHeight>
+using FingerLockFreeSkipList =
+    LockFreeSkipList<T, MaximumHeight, EpochBasedReclamation,
+                     HeapNodeAllocator, HalfHeightGenerator, std::less<T>,
+                     NoSnapshots, ThreadFinger>;
+
+template <typename T, std::uint16_t MaximumHeight>
+using PrefetchingLockFreeSkipList =
+    LockFreeSkipList<T, MaximumHeight, EpochBasedReclamation,
+                     HeapNodeAllocator, HalfHeightGenerator, std::less<T>,
+                     NoSnapshots, NoFinger, SuccessorPrefetching>;
+
+static const std::size_t NumberOfItems = 1000000;
+
+static void createBenchmarks(
+    std::vector<BenchmarkConfiguration>& benchmarks, std::uint16_t listHeight,
+    const std::function<std::unique_ptr<SkipList<long>>()>& listFactory,
+    const std::vector<Scaling>& scalingModes,
+    const std::vector<std::size_t>& threadCounts,
+    const std::vector<std::size_t>& initialSizes)
 {
     BenchmarkConfiguration benchmarkTemplate;
     benchmarkTemplate.repetitions = 30;
-    benchmarkTemplate.listHeight = SkipListHeight;
-    benchmarkTemplate.numberOfItems = 1000000;
-    benchmarkTemplate.listFactory = [] {
-        return std::make_unique<T<long, SkipListHeight>>();
-    };
+    benchmarkTemplate.listHeight = listHeight;
+    benchmarkTemplate.numberOfItems = NumberOfItems;
+    benchmarkTemplate.listFactory = listFactory;
 
     for (auto initialSize : initialSizes) {
         benchmarkTemplate.initialNumberOfItems = initialSize;
@@ -37,7 +130,7 @@ static void createBenchmarks(std::vector<BenchmarkConfiguration>& benchmarks,
             for (auto threads : threadCounts) {
                 benchmarkTemplate.numberOfThreads = threads;
 
-                /*{
+                {
                     auto benchmark = benchmarkTemplate;
                     benchmark.description =
                         "ascending insert - no failed inserts";
@@ -53,7 +146,7 @@ static void createBenchmarks(std::vector<BenchmarkConfiguration>& benchmarks,
                     benchmark.workStrategy =
                         WorkStrategy::createDescendingInsertWorkload();
                     benchmarks.push_back(benchmark);
-                }*/
+                }
 
                 {
                     auto benchmark = benchmarkTemplate;
@@ -64,7 +157,7 @@ static void createBenchmarks(std::vector<BenchmarkConfiguration>& benchmarks,
                     benchmarks.push_back(benchmark);
                 }
 
-                /*{
+                {
                     auto benchmark = benchmarkTemplate;
                     benchmark.description =
                         "ascending remove - no failed removes";
@@ -80,7 +173,7 @@ static void createBenchmarks(std::vector<BenchmarkConfiguration>& benchmarks,
                     benchmark.workStrategy =
                         WorkStrategy::createDescendingRemoveWorkload();
                     benchmarks.push_back(benchmark);
-                }*/
+                }
 
                 {
                     auto benchmark = benchmarkTemplate;
@@ -108,11 +201,76 @@ static void createBenchmarks(std::vector<BenchmarkConfiguration>& benchmarks,
                         WorkStrategy::createMixedWorkload(0.5, 0.2);
                     benchmarks.push_back(benchmark);
                 }
+
+                {
+                    auto benchmark = benchmarkTemplate;
+                    benchmark.description =
+                        "read-mostly workload - 10% update / 90% search";
+                    benchmark.workStrategy =
+                        WorkStrategy::createReadMostlyWorkload(0.1);
+                    benchmarks.push_back(benchmark);
+                }
+
+                {
+                    auto benchmark = benchmarkTemplate;
+                    benchmark.description =
+                        "read-mostly workload - 5% update / 95% search";
+                    benchmark.workStrategy =
+                        WorkStrategy::createReadMostlyWorkload(0.05);
+                    benchmarks.push_back(benchmark);
+                }
+
+                {
+                    auto benchmark = benchmarkTemplate;
+                    benchmark.description =
+                        "range scan - 20% update / 80% scan of 100 values";
+                    benchmark.workStrategy =
+                        WorkStrategy::createRangeScanWorkload(0.2, 100);
+                    benchmarks.push_back(benchmark);
+                }
             }
         }
     }
 }
 
+template <template <typename, std::uint16_t, typename...> class T,
+          std::uint16_t SkipListHeight>
+static void createBenchmarks(std::vector<BenchmarkConfiguration>& benchmarks,
+                             const std::vector<Scaling>& scalingModes,
+                             const std::vector<std::size_t>& threadCounts,
+                             const std::vector<std::size_t>& initialSizes)
+{
+    createBenchmarks(
+        benchmarks, SkipListHeight,
+        [] { return std::make_unique<T<long, SkipListHeight>>(); },
+        scalingModes, threadCounts, initialSizes);
+}
+
+/**
+ * Benchmarks PartitionedSkipList<Inner> with `numberOfShards` shards of equal
+ * width over the values of the workloads.
+ */
+template <template <typename, std::uint16_t, typename...> class Inner,
+          std::uint16_t SkipListHeight>
+static void
+createPartitionedBenchmarks(std::vector<BenchmarkConfiguration>& benchmarks,
+                            std::size_t numberOfShards,
+                            const std::vector<Scaling>& scalingModes,
+                            const std::vector<std::size_t>& threadCounts,
+                            const std::vector<std::size_t>& initialSizes)
+{
+    using List = PartitionedSkipList<Inner<long, SkipListHeight>>;
+
+    const auto maximumInitialSize =
+        *std::max_element(initialSizes.begin(), initialSizes.end());
+    const auto boundaries = List::evenBoundaries(
+        0, NumberOfItems + maximumInitialSize, numberOfShards);
+    createBenchmarks(
+        benchmarks, SkipListHeight,
+        [boundaries] { return std::make_unique<List>(boundaries); },
+        scalingModes, threadCounts, initialSizes);
+}
+
 int main(int argc, char** argv)
 {
     auto benchmark_enabled = [argc, argv](std::string name) {
@@ -123,6 +281,8 @@ int main(int argc, char** argv)
     const std::vector<Scaling> scalingModes = {Scaling::Strong};
     const std::vector<std::size_t> threadCounts = {1, 2, 4, 8, 12, 16, 24, 32, 40, 48};
     const std::vector<std::size_t> initialSizes = {0};
+    // lists which exceed the last-level cache, to compare prefetching
+    const std::vector<std::size_t> largeInitialSizes = {8 * NumberOfItems};
 
     if (benchmark_enabled("SequentialSkipList")) {
         std::cout << "Running SequentialSkipList benchmark:" << std::endl;
@@ -134,6 +294,30 @@ int main(int argc, char** argv)
         saveBenchmarksAsCsv(runBenchmarks(benchmarks), "SequentialSkipList");
     }
 
+    if (benchmark_enabled("FingerSequentialSkipList")) {
+        std::cout << "Running FingerSequentialSkipList benchmark:"
+                  << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<FingerSequentialSkipList, 16>(
+            benchmarks, scalingModes, {1}, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks),
+                            "FingerSequentialSkipList");
+    }
+
+    if (benchmark_enabled("CachedKeySequentialSkipList")) {
+        std::cout << "Running CachedKeySequentialSkipList benchmark:"
+                  << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<CachedKeySequentialSkipList, 16>(
+            benchmarks, scalingModes, {1}, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks),
+                            "CachedKeySequentialSkipList");
+    }
+
     if (benchmark_enabled("ConcurrentSkipList")) {
         std::cout << "Running ConcurrentSkipList benchmark:" << std::endl;
 
@@ -144,6 +328,70 @@ int main(int argc, char** argv)
         saveBenchmarksAsCsv(runBenchmarks(benchmarks), "ConcurrentSkipList");
     }
 
+    if (benchmark_enabled("TicketConcurrentSkipList")) {
+        std::cout << "Running TicketConcurrentSkipList benchmark:" << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<TicketConcurrentSkipList, 16>(
+            benchmarks, scalingModes, threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks),
+                            "TicketConcurrentSkipList");
+    }
+
+    if (benchmark_enabled("MCSConcurrentSkipList")) {
+        std::cout << "Running MCSConcurrentSkipList benchmark:" << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<MCSConcurrentSkipList, 16>(benchmarks, scalingModes,
+                                                    threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks), "MCSConcurrentSkipList");
+    }
+
+    if (benchmark_enabled("CLHConcurrentSkipList")) {
+        std::cout << "Running CLHConcurrentSkipList benchmark:" << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<CLHConcurrentSkipList, 16>(benchmarks, scalingModes,
+                                                    threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks), "CLHConcurrentSkipList");
+    }
+
+    if (benchmark_enabled("SharedConcurrentSkipList")) {
+        std::cout << "Running SharedConcurrentSkipList benchmark:" << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<SharedConcurrentSkipList, 16>(
+            benchmarks, scalingModes, threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks),
+                            "SharedConcurrentSkipList");
+    }
+
+    if (benchmark_enabled("RcuConcurrentSkipList")) {
+        std::cout << "Running RcuConcurrentSkipList benchmark:" << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<RcuConcurrentSkipList, 16>(
+            benchmarks, scalingModes, threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks),
+                            "RcuConcurrentSkipList");
+    }
+
+    if (benchmark_enabled("FlatCombiningSkipList")) {
+        std::cout << "Running FlatCombiningSkipList benchmark:" << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<FlatCombiningSkipList, 16>(
+            benchmarks, scalingModes, threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks),
+                            "FlatCombiningSkipList");
+    }
+
     if (benchmark_enabled("LazySkipList")) {
         std::cout << "Running LazySkipList benchmark:" << std::endl;
 
@@ -154,6 +402,65 @@ int main(int argc, char** argv)
         saveBenchmarksAsCsv(runBenchmarks(benchmarks), "LazySkipList");
     }
 
+    if (benchmark_enabled("PartitionedLazySkipList")) {
+        std::cout << "Running PartitionedLazySkipList benchmark:" << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createPartitionedBenchmarks<LazySkipList, 16>(
+            benchmarks, 16, scalingModes, threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks),
+                            "PartitionedLazySkipList");
+    }
+
+    if (benchmark_enabled("FingerLazySkipList")) {
+        std::cout << "Running FingerLazySkipList benchmark:" << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<FingerLazySkipList, 16>(benchmarks, scalingModes,
+                                                 threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks), "FingerLazySkipList");
+    }
+
+    if (benchmark_enabled("CachedKeyLazySkipList")) {
+        std::cout << "Running CachedKeyLazySkipList benchmark:" << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<CachedKeyLazySkipList, 16>(
+            benchmarks, scalingModes, threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks),
+                            "CachedKeyLazySkipList");
+    }
+
+    if (benchmark_enabled("PrefetchingLazySkipList")) {
+        std::cout << "Running PrefetchingLazySkipList benchmark:" << std::endl;
+
+        // A/B against the list without prefetching on the same sizes
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<PrefetchingLazySkipList, 16>(
+            benchmarks, scalingModes, threadCounts, largeInitialSizes);
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks),
+                            "PrefetchingLazySkipList");
+
+        benchmarks.clear();
+        createBenchmarks<LazySkipList, 16>(benchmarks, scalingModes,
+                                           threadCounts, largeInitialSizes);
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks), "LargeLazySkipList");
+    }
+
+    if (benchmark_enabled("OptimisticLazySkipList")) {
+        std::cout << "Running OptimisticLazySkipList benchmark:" << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<OptimisticLazySkipList, 16>(
+            benchmarks, scalingModes, threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks),
+                            "OptimisticLazySkipList");
+    }
+
     if (benchmark_enabled("LockFreeSkipList")) {
         std::cout << "Running LockFreeSkipList benchmark:" << std::endl;
 
@@ -164,6 +471,122 @@ int main(int argc, char** argv)
         saveBenchmarksAsCsv(runBenchmarks(benchmarks), "LockFreeSkipList");
     }
 
+    if (benchmark_enabled("NoHotSpotSkipList")) {
+        std::cout << "Running NoHotSpotSkipList benchmark:" << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<NoHotSpotSkipList, 16>(benchmarks, scalingModes,
+                                                threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks), "NoHotSpotSkipList");
+    }
+
+    if (benchmark_enabled("UnrolledSkipList")) {
+        std::cout << "Running UnrolledSkipList benchmark:" << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<DefaultUnrolledSkipList, 16>(
+            benchmarks, scalingModes, threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks), "UnrolledSkipList");
+    }
+
+    if (benchmark_enabled("PartitionedLockFreeSkipList")) {
+        std::cout << "Running PartitionedLockFreeSkipList benchmark:"
+                  << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createPartitionedBenchmarks<LockFreeSkipList, 16>(
+            benchmarks, 16, scalingModes, threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks),
+                            "PartitionedLockFreeSkipList");
+    }
+
+    if (benchmark_enabled("PrefetchingLockFreeSkipList")) {
+        std::cout << "Running PrefetchingLockFreeSkipList benchmark:"
+                  << std::endl;
+
+        // A/B against the list without prefetching on the same sizes
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<PrefetchingLockFreeSkipList, 16>(
+            benchmarks, scalingModes, threadCounts, largeInitialSizes);
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks),
+                            "PrefetchingLockFreeSkipList");
+
+        benchmarks.clear();
+        createBenchmarks<LockFreeSkipList, 16>(
+            benchmarks, scalingModes, threadCounts, largeInitialSizes);
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks),
+                            "LargeLockFreeSkipList");
+    }
+
+    if (benchmark_enabled("FingerLockFreeSkipList")) {
+        std::cout << "Running FingerLockFreeSkipList benchmark:" << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<FingerLockFreeSkipList, 16>(
+            benchmarks, scalingModes, threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks),
+                            "FingerLockFreeSkipList");
+    }
+
+    if (benchmark_enabled("HazardPointerLockFreeSkipList")) {
+        std::cout << "Running HazardPointerLockFreeSkipList benchmark:"
+                  << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<HazardPointerLockFreeSkipList, 16>(
+            benchmarks, scalingModes, threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks),
+                            "HazardPointerLockFreeSkipList");
+    }
+
+    if (benchmark_enabled("LeakingLockFreeSkipList")) {
+        std::cout << "Running LeakingLockFreeSkipList benchmark:" << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<LeakingLockFreeSkipList, 16>(
+            benchmarks, scalingModes, threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks),
+                            "LeakingLockFreeSkipList");
+    }
+
+    if (benchmark_enabled("SlabLazySkipList")) {
+        std::cout << "Running SlabLazySkipList benchmark:" << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<SlabLazySkipList, 16>(benchmarks, scalingModes,
+                                               threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks), "SlabLazySkipList");
+    }
+
+    if (benchmark_enabled("SlabLockFreeSkipList")) {
+        std::cout << "Running SlabLockFreeSkipList benchmark:" << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<SlabLockFreeSkipList, 16>(benchmarks, scalingModes,
+                                                   threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks), "SlabLockFreeSkipList");
+    }
+
+    if (benchmark_enabled("HugePageLockFreeSkipList")) {
+        std::cout << "Running HugePageLockFreeSkipList benchmark:"
+                  << std::endl;
+
+        std::vector<BenchmarkConfiguration> benchmarks;
+        createBenchmarks<HugePageLockFreeSkipList, 16>(
+            benchmarks, scalingModes, threadCounts, initialSizes);
+
+        saveBenchmarksAsCsv(runBenchmarks(benchmarks),
+                            "HugePageLockFreeSkipList");
+    }
+
     if (benchmark_enabled("MMLazySkipList")) {
         std::cout << "Running MMLazySkipList benchmark:" << std::endl;
 
@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/thread/barrier.hpp>
+
+#include "Benchmarking.h"
+#include "LockFreeSkipList.h"
+#include "Thread.h"
+#include "Timer.h"
+
+/**
+ * Measures the update throughput of the lock-free list while one thread
+ * repeatedly scans the whole list, comparing weakly consistent scans with
+ * snapshot scans. Snapshots label every update and delay the reclamation of
+ * removed nodes while they run.
+ */
+
+enum class ScanMode { None, Weak, Snapshot };
+
+struct SnapshotResult {
+    std::string list;
+    std::string scanMode;
+    std::size_t numberOfUpdaters;
+    std::uint16_t repetition;
+    double totalTime;
+    double throughput;
+    std::size_t numberOfScans;
+};
+
+static std::string scanModeName(ScanMode mode)
+{
+    switch (mode) {
+    case ScanMode::None:
+        return "no scans";
+    case ScanMode::Weak:
+        return "rangeScan";
+    case ScanMode::Snapshot:
+        return "snapshotScan";
+    }
+    return "";
+}
+
+template <typename List>
+static std::size_t weakScan(List& list, long hi)
+{
+    std::size_t count = 0;
+    list.rangeScan(0, hi, [&count](long) { ++count; });
+    return count;
+}
+
+template <typename List>
+static std::size_t snapshotScan(List& list, long hi)
+{
+    std::size_t count = 0;
+    list.snapshotScan(0, hi, [&count](long) { ++count; });
+    return count;
+}
+
+/**
+ * @param scan Scans the whole list, unused if `mode` is `ScanMode::None`
+ */
+template <typename List, typename Scan>
+static std::vector<SnapshotResult>
+runSnapshotBenchmark(const std::string& listName, ScanMode mode, Scan scan,
+                     std::size_t numberOfUpdaters, long numberOfValues,
+                     std::size_t numberOfUpdates, std::uint16_t repetitions)
+{
+    std::vector<SnapshotResult> results;
+
+    for (std::uint16_t repetition = 1; repetition <= repetitions;
+         ++repetition) {
+        List list;
+        for (long value = 0; value < numberOfValues; value += 2) {
+            list.insert(value);
+        }
+
+        // the scanning thread is the last one and runs until the updaters
+        // are done
+        const auto numberOfThreads =
+            numberOfUpdaters + (mode == ScanMode::None ? 0 : 1);
+        boost::barrier barrier(numberOfThreads);
+        std::atomic<std::size_t> runningUpdaters(numberOfUpdaters);
+        std::atomic<std::size_t> numberOfScans(0);
+        Timer<std::chrono::high_resolution_clock> timer;
+
+        const auto updatesPerThread = numberOfUpdates / numberOfUpdaters;
+        Thread::parallel(
+            [&] {
+                const auto threadId = Thread::currentThreadId();
+                std::mt19937 generator(threadId);
+                std::uniform_int_distribution<long> values(0,
+                                                           numberOfValues - 1);
+
+                barrier.wait();
+                Thread::single([&] { timer.start(); });
+
+                if (threadId >= numberOfUpdaters) {
+                    while (runningUpdaters.load() > 0) {
+                        scan(list, numberOfValues);
+                        ++numberOfScans;
+                    }
+                } else {
+                    for (std::size_t i = 0; i < updatesPerThread; ++i) {
+                        const auto value = values(generator);
+                        if (i % 2 == 0) {
+                            list.insert(value);
+                        } else {
+                            list.remove(value);
+                        }
+                    }
+                    if (--runningUpdaters == 0) {
+                        timer.stop();
+                    }
+                }
+
+                barrier.wait();
+            },
+            numberOfThreads);
+
+        SnapshotResult result;
+        result.list = listName;
+        result.scanMode = scanModeName(mode);
+        result.numberOfUpdaters = numberOfUpdaters;
+        result.repetition = repetition;
+        result.totalTime =
+            timer.elapsed().count() / 1000.0 / 1000.0 / 1000.0;
+        result.throughput =
+            updatesPerThread * numberOfUpdaters / result.totalTime;
+        result.numberOfScans = numberOfScans.load();
+        results.push_back(result);
+
+        std::cout << listName << " - " << result.scanMode << " - "
+                  << numberOfUpdaters << " updaters - "
+                  << std::to_string(result.throughput) << " updates/s - "
+                  << result.numberOfScans << " scans" << std::endl;
+    }
+
+    return results;
+}
+
+static void saveResultsAsCsv(const std::vector<SnapshotResult>& results,
+                             const std::string& fileNamePrefix)
+{
+    const auto seperator = ";";
+    const auto fileName = csvFileName(fileNamePrefix);
+
+    std::ofstream file(fileName, std::ofstream::trunc);
+    for (const auto& result : results) {
+        file << result.list << seperator << result.scanMode << seperator
+             << std::to_string(result.numberOfUpdaters) << seperator
+             << std::to_string(result.repetition) << seperator
+             << std::to_string(result.totalTime) << seperator
+             << std::to_string(result.throughput) << seperator
+             << std::to_string(result.numberOfScans) << seperator << "\n";
+    }
+    file.close();
+
+    std::cout << "Saved benchmark results to `" << fileName << "`" << std::endl;
+}
+
+int main()
+{
+    using UnversionedList = LockFreeSkipList<long, 16>;
+    using VersionedList =
+        LockFreeSkipList<long, 16, EpochBasedReclamation, HeapNodeAllocator,
+                         HalfHeightGenerator, std::less<long>,
+                         VersionedSnapshots>;
+
+    const std::vector<std::size_t> updaterCounts = {1, 4, 8, 16};
+    const long numberOfValues = 200000;
+    const std::size_t numberOfUpdates = 1600000;
+    const std::uint16_t repetitions = 3;
+
+    std::vector<SnapshotResult> results;
+    const auto append = [&results](const std::vector<SnapshotResult>& more) {
+        results.insert(results.end(), more.begin(), more.end());
+    };
+
+    for (auto updaters : updaterCounts) {
+        append(runSnapshotBenchmark<UnversionedList>(
+            "LockFreeSkipList", ScanMode::None, weakScan<UnversionedList>,
+            updaters, numberOfValues, numberOfUpdates, repetitions));
+        append(runSnapshotBenchmark<UnversionedList>(
+            "LockFreeSkipList", ScanMode::Weak, weakScan<UnversionedList>,
+            updaters, numberOfValues, numberOfUpdates, repetitions));
+        append(runSnapshotBenchmark<VersionedList>(
+            "versioned LockFreeSkipList", ScanMode::None,
+            weakScan<VersionedList>, updaters, numberOfValues,
+            numberOfUpdates, repetitions));
+        append(runSnapshotBenchmark<VersionedList>(
+            "versioned LockFreeSkipList", ScanMode::Weak,
+            weakScan<VersionedList>, updaters, numberOfValues,
+            numberOfUpdates, repetitions));
+        append(runSnapshotBenchmark<VersionedList>(
+            "versioned LockFreeSkipList", ScanMode::Snapshot,
+            snapshotScan<VersionedList>, updaters, numberOfValues,
+            numberOfUpdates, repetitions));
+    }
+
+    saveResultsAsCsv(results, "SnapshotBenchmark");
+
+    return EXIT_SUCCESS;
+}
@@ -2,21 +2,29 @@
 
 #include <cassert>
 #include <cmath>
+#include <numeric>
 #include <random>
+#include <vector>
 
 #include "Benchmarking.h"
 #include "Thread.h"
 
 namespace WorkStrategy
 {
+/**
+ * Fills the list with the values [0, numberOfItems[.
+ */
+static void fill(SkipList<long>& list, long numberOfItems)
+{
+    std::vector<long> values(numberOfItems);
+    std::iota(values.begin(), values.end(), 0);
+    list.bulkLoad(values.data(), values.data() + values.size());
+}
+
 static void DefaultPrepare(const BaseBenchmarkConfiguration& config,
                            SkipList<long>& list)
 {
-    Thread::single([&] {
-        for (long i = 0; i < config.initialNumberOfItems; i++) {
-            list.insert(i);
-        }
-    });
+    Thread::single([&] { fill(list, config.initialNumberOfItems); });
 }
 
 static void DefaultCleanup(const BaseBenchmarkConfiguration&, SkipList<long>&)
@@ -91,11 +99,8 @@ static void RemoveWorkloadPrepare(const BaseBenchmarkConfiguration& config,
                                   SkipList<long>& list)
 {
     Thread::single([&] {
-        const auto items = config.initialNumberOfItems +
-                           itemsPerThread(config) * config.numberOfThreads;
-        for (long i = 0; i < items; i++) {
-            list.insert(i);
-        }
+        fill(list, config.initialNumberOfItems +
+                       itemsPerThread(config) * config.numberOfThreads);
     });
 }
 
@@ -215,4 +220,126 @@ Workload createMixedWorkload(double insertingThreads, double removingThreads)
 
     return {Prepare, Work, Cleanup};
 }
+
+Workload createReadMostlyWorkload(double updatingOperations)
+{
+    assert(updatingOperations >= 0.0 && updatingOperations <= 1.0);
+
+    const auto Prepare = [](const BaseBenchmarkConfiguration& config,
+                            SkipList<long>& list) {
+        DefaultPrepare(config, list);
+
+        const long begin = config.initialNumberOfItems;
+        const long end = begin + config.numberOfItems;
+        Thread::single([&] {
+            std::vector<long> values;
+            values.reserve(config.numberOfItems / 2 + 1);
+            for (long value = begin; value < end; value += 2) {
+                values.push_back(value);
+            }
+            list.bulkLoad(values.data(), values.data() + values.size());
+        });
+
+        const auto items = itemsPerThread(config);
+
+        std::random_device randomDevice;
+        std::mt19937 generator(randomDevice());
+        std::uniform_int_distribution<long> distribution(begin, end - 1);
+
+        tl_randomNumbers.reserve(items);
+        for (long i = 0; i < items; i++) {
+            tl_randomNumbers.emplace_back(distribution(generator));
+        }
+    };
+
+    const auto Work = [=](const BaseBenchmarkConfiguration& config,
+                          SkipList<long>& list) {
+        // of every 100 operations the first ones update, alternately
+        // inserting a value and removing the one inserted before
+        const long updatesPer100 = std::lround(updatingOperations * 100);
+
+        const auto items = itemsPerThread(config);
+
+        long inserted = -1;
+        for (long i = 0; i < items; i++) {
+            if (i % 100 >= updatesPer100) {
+                list.contains(tl_randomNumbers[i]);
+            } else if (inserted == -1) {
+                inserted = tl_randomNumbers[i];
+                list.insert(inserted);
+            } else {
+                list.remove(inserted);
+                inserted = -1;
+            }
+        }
+    };
+
+    const auto Cleanup = [](const BaseBenchmarkConfiguration& config,
+                            SkipList<long>& list) {
+        DefaultCleanup(config, list);
+
+        tl_randomNumbers.clear();
+    };
+
+    return {Prepare, Work, Cleanup};
+}
+
+Workload createRangeScanWorkload(double updatingThreads, long rangeLength)
+{
+    assert(updatingThreads >= 0.0 && updatingThreads <= 1.0);
+    assert(rangeLength > 0);
+
+    const auto Prepare = [](const BaseBenchmarkConfiguration& config,
+                            SkipList<long>& list) {
+        DefaultPrepare(config, list);
+
+        const auto items = itemsPerThread(config);
+
+        std::random_device randomDevice;
+        std::mt19937 generator(randomDevice());
+        std::uniform_int_distribution<long> distribution(
+            0, config.initialNumberOfItems + items);
+
+        tl_randomNumbers.reserve(items);
+        for (long i = 0; i < items; i++) {
+            tl_randomNumbers.emplace_back(distribution(generator));
+        }
+    };
+
+    const auto Work = [=](const BaseBenchmarkConfiguration& config,
+                          SkipList<long>& list) {
+        //  0 updating ST scanning
+        //  [ ........ | ........ [
+        const std::size_t ST =
+            std::ceil(updatingThreads * config.numberOfThreads);
+
+        const auto threadId = Thread::currentThreadId();
+
+        const auto items = itemsPerThread(config);
+
+        if (threadId >= ST) { // scanning, visits about `items` values
+            for (long i = 0; i < items / rangeLength; i++) {
+                const auto lo = tl_randomNumbers[i];
+                list.rangeScan(lo, lo + rangeLength, [](const long&) {});
+            }
+        } else { // updating
+            for (long i = 0; i < items; i++) {
+                if (i % 2 == 0) {
+                    list.insert(tl_randomNumbers[i]);
+                } else {
+                    list.remove(tl_randomNumbers[i - 1]);
+                }
+            }
+        }
+    };
+
+    const auto Cleanup = [](const BaseBenchmarkConfiguration& config,
+                            SkipList<long>& list) {
+        DefaultCleanup(config, list);
+
+        tl_randomNumbers.clear();
+    };
+
+    return {Prepare, Work, Cleanup};
+}
 }
@@ -29,4 +29,19 @@ Workload createDescendingRemoveWorkload();
 Workload createInterleavingRemoveWorkload();
 
 Workload createMixedWorkload(double insertingThreads, double removingThreads);
+
+/**
+ * Every thread mixes its operations: the `updatingOperations` fraction of
+ * them inserts random values and removes them again, the others search
+ * random values. The list is filled with every other value of the searched
+ * range beforehand, so that about half of the searches succeed.
+ */
+Workload createReadMostlyWorkload(double updatingOperations);
+
+/**
+ * The first `updatingThreads` fraction of the threads inserts and removes
+ * random values, the others scan ranges of `rangeLength` values starting at
+ * random values. Every scan counts as one lookup.
+ */
+Workload createRangeScanWorkload(double updatingThreads, long rangeLength);
 }
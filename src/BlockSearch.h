@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/**
+ * Search in a small sorted array of keys (the block of a node of
+ * UnrolledSkipList).
+ *
+ * `rank(keys, count, value, compare)` returns the number of keys which are
+ * less than `value`, i.e. the index of the lower bound. In general it's a
+ * binary search, for 32 and 64 bit integers ordered by std::less it counts
+ * the smaller keys with AVX2 compare and movemask if the processor supports
+ * it (checked once at runtime, so that the build needs no `-mavx2`), which
+ * has no branches to mispredict and reads the block sequentially.
+ */
+template <typename T, typename Compare>
+struct BlockSearch {
+    static std::size_t rank(const T* keys, std::size_t count, const T& value,
+                            const Compare& compare)
+    {
+        return std::lower_bound(keys, keys + count, value, compare) - keys;
+    }
+};
+
+#if defined(__x86_64__)
+
+namespace BlockSearchDetail
+{
+inline bool hasAvx2()
+{
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+__attribute__((target("avx2"))) inline std::size_t
+rankAvx2(const std::int32_t* keys, std::size_t count, std::int32_t value)
+{
+    const __m256i needle = _mm256_set1_epi32(value);
+    std::size_t rank = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i block =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+        const int less = _mm256_movemask_ps(
+            _mm256_castsi256_ps(_mm256_cmpgt_epi32(needle, block)));
+        rank += __builtin_popcount(less);
+        if (less != 0xff) {
+            return rank;
+        }
+    }
+    for (; i < count && keys[i] < value; ++i) {
+        ++rank;
+    }
+    return rank;
+}
+
+__attribute__((target("avx2"))) inline std::size_t
+rankAvx2(const std::int64_t* keys, std::size_t count, std::int64_t value)
+{
+    const __m256i needle = _mm256_set1_epi64x(value);
+    std::size_t rank = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256i block =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+        const int less = _mm256_movemask_pd(
+            _mm256_castsi256_pd(_mm256_cmpgt_epi64(needle, block)));
+        rank += __builtin_popcount(less);
+        if (less != 0xf) {
+            return rank;
+        }
+    }
+    for (; i < count && keys[i] < value; ++i) {
+        ++rank;
+    }
+    return rank;
+}
+
+template <typename T>
+struct VectorBlockSearch {
+    static std::size_t rank(const T* keys, std::size_t count, const T& value,
+                            const std::less<T>& compare)
+    {
+        if (hasAvx2()) {
+            return rankAvx2(keys, count, value);
+        }
+        return BlockSearch<T, std::less<T>>::rank(keys, count, value,
+                                                  compare);
+    }
+};
+}
+
+template <>
+struct BlockSearch<std::int32_t, std::less<std::int32_t>>
+    : BlockSearchDetail::VectorBlockSearch<std::int32_t> {
+};
+
+template <>
+struct BlockSearch<std::int64_t, std::less<std::int64_t>>
+    : BlockSearchDetail::VectorBlockSearch<std::int64_t> {
+};
+
+#endif
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+/**
+ * Builds the towers of an empty skip list bottom-up from sorted input in
+ * linear time, instead of searching the insert position of every value.
+ *
+ * The input is split into segments of `SegmentSize` values. Each segment
+ * creates its nodes in ascending order and appends them to the levels of
+ * their towers, remembering the first and last node per level. The segments
+ * are built concurrently by up to `std::thread::hardware_concurrency()`
+ * threads and stitched together between head and sentinel afterwards, which
+ * takes O(segments * MaximumHeight).
+ *
+ * The list provides `createNode(iterator, height)`, which must be safe to be
+ * called concurrently (the allocators are), and `link(pred, level, succ)`.
+ */
+template <typename Node, std::uint16_t MaximumHeight,
+          typename HeightGenerator>
+class BulkLoader
+{
+  public:
+    static const std::size_t SegmentSize = 64 * 1024;
+
+    struct Result {
+        std::size_t count;    /**< number of created nodes */
+        std::uint16_t height; /**< height of the highest node */
+    };
+
+  private:
+    template <typename Iterator>
+    struct Segment {
+        Iterator begin;
+        Iterator end;
+        std::array<Node*, MaximumHeight> first;
+        std::array<Node*, MaximumHeight> last;
+        std::size_t count;
+        std::uint16_t height;
+    };
+
+  public:
+    /**
+     * Links the values of the sorted range [first, last) between `head` and
+     * `sentinel`, which must be linked to each other on all levels. Equal
+     * values (neither is less than the other) are only inserted once.
+     * @param getKey Returns the key of `*iterator`, which is compared by
+     * `compare`
+     */
+    template <typename Iterator, typename GetKey, typename Compare,
+              typename CreateNode, typename Link>
+    static Result load(Node* head, Node* sentinel, Iterator first,
+                       Iterator last, GetKey getKey, const Compare& compare,
+                       CreateNode createNode, Link link)
+    {
+        auto segments = split(first, last, getKey, compare);
+
+        const auto build = [&](Segment<Iterator>& segment) {
+            buildSegment(segment, getKey, compare, createNode, link);
+        };
+        const auto numberOfThreads = std::min<std::size_t>(
+            segments.size(), std::max(1u, std::thread::hardware_concurrency()));
+        if (numberOfThreads <= 1) {
+            for (auto& segment : segments) {
+                build(segment);
+            }
+        } else {
+            // the calling thread builds segments as well
+            std::atomic<std::size_t> nextSegment(0);
+            const auto work = [&] {
+                for (auto index = nextSegment++; index < segments.size();
+                     index = nextSegment++) {
+                    build(segments[index]);
+                }
+            };
+            std::vector<std::thread> threads;
+            for (std::size_t i = 1; i < numberOfThreads; ++i) {
+                threads.emplace_back(work);
+            }
+            work();
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+        // stitch the segments together
+        Result result = {0, 0};
+        std::array<Node*, MaximumHeight> predecessors;
+        predecessors.fill(head);
+        for (const auto& segment : segments) {
+            for (std::uint16_t level = 0;
+                 segment.count > 0 && level <= segment.height; ++level) {
+                link(predecessors[level], level, segment.first[level]);
+                predecessors[level] = segment.last[level];
+            }
+            result.count += segment.count;
+            result.height = std::max(result.height, segment.height);
+        }
+        for (std::uint16_t level = 0; level < MaximumHeight; ++level) {
+            link(predecessors[level], level, sentinel);
+        }
+        return result;
+    }
+
+  private:
+    /**
+     * Splits the input into segments of about `SegmentSize` values, equal
+     * values are kept in the same segment.
+     */
+    template <typename Iterator, typename GetKey, typename Compare>
+    static std::vector<Segment<Iterator>>
+    split(Iterator first, Iterator last, GetKey getKey, const Compare& compare)
+    {
+        std::vector<Segment<Iterator>> segments;
+        for (auto begin = first; begin != last;) {
+            auto end = begin + std::min<std::size_t>(
+                                   SegmentSize, std::distance(begin, last));
+            while (end != last && !compare(getKey(*(end - 1)), getKey(*end))) {
+                ++end;
+            }
+
+            Segment<Iterator> segment;
+            segment.begin = begin;
+            segment.end = end;
+            segments.push_back(segment);
+            begin = end;
+        }
+        return segments;
+    }
+
+    template <typename Iterator, typename GetKey, typename Compare,
+              typename CreateNode, typename Link>
+    static void buildSegment(Segment<Iterator>& segment, GetKey getKey,
+                             const Compare& compare, CreateNode createNode,
+                             Link link)
+    {
+        segment.first.fill(nullptr);
+        segment.last.fill(nullptr);
+        segment.count = 0;
+        segment.height = 0;
+
+        for (auto current = segment.begin; current != segment.end;
+             ++current) {
+            if (current != segment.begin &&
+                !compare(getKey(*(current - 1)), getKey(*current))) {
+                continue; // duplicate
+            }
+
+            const auto height =
+                HeightGenerator::template generate<MaximumHeight>();
+            auto* node = createNode(current, height);
+            for (std::uint16_t level = 0; level <= height; ++level) {
+                if (segment.last[level] == nullptr) {
+                    segment.first[level] = node;
+                } else {
+                    link(segment.last[level], level, node);
+                }
+                segment.last[level] = node;
+            }
+            ++segment.count;
+            segment.height = std::max(segment.height, height);
+        }
+    }
+};
+
+template <typename Node, std::uint16_t MaximumHeight, typename HeightGenerator>
+const std::size_t BulkLoader<Node, MaximumHeight, HeightGenerator>::SegmentSize;
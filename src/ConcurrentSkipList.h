@@ -1,10 +1,89 @@
 #pragma once
 
 #include <mutex>
+#if __cplusplus >= 201402L
+#include <shared_mutex>
+#endif
 
 #include "SequentialSkipList.h"
+#include "SpinLock.h"
 
-template <typename T, std::uint16_t MaximumHeight>
+/**
+ * Locking policy of ConcurrentSkipList which serializes all operations by a
+ * mutex.
+ */
+struct ExclusiveLocking {
+    using Mutex = std::mutex;
+    using ReadLock = std::lock_guard<Mutex>;
+
+    template <typename T, std::uint16_t MaximumHeight>
+    using List = SequentialSkipList<T, MaximumHeight>;
+};
+
+/**
+ * Locking policy of ConcurrentSkipList which serializes all operations by a
+ * fair lock, which admits waiting threads in the order they arrived instead
+ * of letting a releasing thread reacquire `std::mutex` at once and starve
+ * the others.
+ *
+ * @tparam Lock TicketLock, MCSLock or CLHLock
+ */
+template <typename Lock>
+struct QueueLocking {
+    using Mutex = Lock;
+    using ReadLock = std::lock_guard<Mutex>;
+
+    template <typename T, std::uint16_t MaximumHeight>
+    using List = SequentialSkipList<T, MaximumHeight>;
+};
+
+#if __cplusplus >= 201402L
+/**
+ * Locking policy of ConcurrentSkipList which lets lookups share a
+ * reader-writer lock, modifying operations lock it exclusively.
+ */
+struct SharedLocking {
+#if __cplusplus >= 201703L
+    using Mutex = std::shared_mutex;
+#else
+    using Mutex = std::shared_timed_mutex;
+#endif
+    using ReadLock = std::shared_lock<Mutex>;
+
+    template <typename T, std::uint16_t MaximumHeight>
+    using List = SequentialSkipList<T, MaximumHeight>;
+};
+#endif
+
+/**
+ * Locking policy of ConcurrentSkipList which only serializes the modifying
+ * operations, lookups don't lock at all and run concurrently with the
+ * single writer (see RcuAccess).
+ */
+struct RcuLocking {
+    using Mutex = std::mutex;
+
+    struct ReadLock {
+        explicit ReadLock(Mutex&)
+        {
+        }
+    };
+
+    template <typename T, std::uint16_t MaximumHeight>
+    using List =
+        SequentialSkipList<T, MaximumHeight, HeapNodeAllocator,
+                           HalfHeightGenerator, std::less<T>, NoFinger,
+                           RcuAccess>;
+};
+
+/**
+ * SequentialSkipList protected by a lock.
+ *
+ * @tparam Locking ExclusiveLocking, QueueLocking, SharedLocking (C++14) or
+ *                 RcuLocking
+ */
+template <typename T, std::uint16_t MaximumHeight,
+          typename Locking = ExclusiveLocking>
 class ConcurrentSkipList final : public SkipList<T>
 {
   public:
@@ -18,6 +97,11 @@ class ConcurrentSkipList final : public SkipList<T>
     using difference_type = typename SkipList<T>::difference_type;
     using size_type = typename SkipList<T>::size_type;
 
+  private:
+    using Mutex = typename Locking::Mutex;
+    using ReadLock = typename Locking::ReadLock;
+    using WriteLock = std::lock_guard<Mutex>;
+
   public:
     ConcurrentSkipList()
         : m_mutex()
@@ -27,41 +111,83 @@ class ConcurrentSkipList final : public SkipList<T>
 
     bool empty() override
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        ReadLock lock(m_mutex);
         return m_list.empty();
     }
 
     size_type size() override
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        ReadLock lock(m_mutex);
         return m_list.size();
     }
 
     bool insert(const_reference value) override
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        WriteLock lock(m_mutex);
         return m_list.insert(value);
     }
 
     bool remove(const_reference value) override
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        WriteLock lock(m_mutex);
         return m_list.remove(value);
     }
 
     bool contains(const_reference value) override
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        ReadLock lock(m_mutex);
         return m_list.contains(value);
     }
 
+    size_type insertBatch(const_pointer first, const_pointer last,
+                          bool* results) override
+    {
+        WriteLock lock(m_mutex);
+        return m_list.insertBatch(first, last, results);
+    }
+
+    size_type removeBatch(const_pointer first, const_pointer last,
+                          bool* results) override
+    {
+        WriteLock lock(m_mutex);
+        return m_list.removeBatch(first, last, results);
+    }
+
+    size_type containsBatch(const_pointer first, const_pointer last,
+                            bool* results) override
+    {
+        ReadLock lock(m_mutex);
+        return m_list.containsBatch(first, last, results);
+    }
+
+    size_type containsMany(const_pointer first, const_pointer last,
+                           bool* results) override
+    {
+        ReadLock lock(m_mutex);
+        return m_list.containsMany(first, last, results);
+    }
+
+    size_type bulkLoad(const_pointer first, const_pointer last) override
+    {
+        WriteLock lock(m_mutex);
+        return m_list.bulkLoad(first, last);
+    }
+
+    size_type
+    rangeScan(const_reference lo, const_reference hi,
+              const std::function<void(const_reference)>& callback) override
+    {
+        ReadLock lock(m_mutex);
+        return m_list.rangeScan(lo, hi, callback);
+    }
+
     void clear() override
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        WriteLock lock(m_mutex);
         m_list.clear();
     }
 
   private:
-    std::mutex m_mutex;
-    SequentialSkipList<T, MaximumHeight> m_list;
+    Mutex m_mutex;
+    typename Locking::template List<T, MaximumHeight> m_list;
 };
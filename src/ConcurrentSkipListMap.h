@@ -0,0 +1,237 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+
+#include "LazySkipList.h"
+#include "LockFreeSkipList.h"
+#include "SkipListEngine.h"
+
+/**
+ * Ordered concurrent map on top of a skip list engine (see SkipListEngine.h),
+ * all operations need a single traversal of the list.
+ *
+ * Values are stored inline in the nodes and are therefore restricted to
+ * trivially copyable types, they are replaced and updated atomically.
+ */
+template <typename Engine>
+class ConcurrentSkipListMap
+{
+  public:
+    using key_type = typename Engine::key_type;
+    using mapped_type = typename Engine::mapped_type;
+    using size_type = typename Engine::size_type;
+    using const_iterator = typename Engine::const_iterator;
+    using iterator = const_iterator;
+
+  public:
+    bool empty()
+    {
+        return m_engine.empty();
+    }
+
+    size_type size()
+    {
+        return m_engine.size();
+    }
+
+    size_type sizeEstimate()
+    {
+        return m_engine.sizeEstimate();
+    }
+
+    bool contains(const key_type& key)
+    {
+        return m_engine.visit(key, IgnoreMapped());
+    }
+
+    /**
+     * @return true if the key is present, its value is copied into `mapped`
+     */
+    bool get(const key_type& key, mapped_type& mapped)
+    {
+        return m_engine.visit(key, [&mapped](std::atomic<mapped_type>& value) {
+            mapped = value.load();
+        });
+    }
+
+    /**
+     * Inserts the key or replaces its value if it is already present.
+     * @return true if the key has been inserted
+     */
+    bool put(const key_type& key, const mapped_type& mapped)
+    {
+        return m_engine.insert(
+            key, ConstantMapped<mapped_type>(mapped),
+            [&mapped](std::atomic<mapped_type>& value) { value.store(mapped); });
+    }
+
+    /**
+     * @return true if the key has been inserted, false if it was present
+     */
+    bool putIfAbsent(const key_type& key, const mapped_type& mapped)
+    {
+        return m_engine.insert(key, ConstantMapped<mapped_type>(mapped),
+                               IgnoreMapped());
+    }
+
+    /**
+     * Inserts `function(key)` if the key is not present. The function might
+     * be called even if a concurrent operation inserts the key first, its
+     * result is discarded in this case.
+     * @return The value of the key after the operation
+     */
+    template <typename Function>
+    mapped_type computeIfAbsent(const key_type& key, Function function)
+    {
+        mapped_type result = mapped_type();
+        m_engine.insert(key,
+                        [&] {
+                            result = function(key);
+                            return result;
+                        },
+                        [&result](std::atomic<mapped_type>& value) {
+                            result = value.load();
+                        });
+        return result;
+    }
+
+    /**
+     * Atomically replaces the value of the key by `function(value)`, the
+     * function might be called multiple times under contention.
+     * @return false if the key is not present
+     */
+    template <typename Function>
+    bool update(const key_type& key, Function function)
+    {
+        return m_engine.visit(key, [&function](std::atomic<mapped_type>& value) {
+            auto expected = value.load();
+            while (!value.compare_exchange_weak(expected, function(expected))) {
+            }
+        });
+    }
+
+    /**
+     * Atomically adds `delta` to the value of the key, an absent key is
+     * inserted with value `delta`. Requires an integral value type.
+     * @return The value before the addition, `mapped_type()` if the key has
+     * been inserted
+     */
+    mapped_type fetchAdd(const key_type& key, const mapped_type& delta)
+    {
+        mapped_type previous = mapped_type();
+        m_engine.insert(key, ConstantMapped<mapped_type>(delta),
+                        [&](std::atomic<mapped_type>& value) {
+                            previous = value.fetch_add(delta);
+                        });
+        return previous;
+    }
+
+    bool remove(const key_type& key)
+    {
+        return m_engine.remove(key);
+    }
+
+    /**
+     * Inserts the key-value pairs (`first` and `second`) of the range
+     * [first, last), which is sorted by key. See SkipList::bulkLoad.
+     * @return Number of inserted keys
+     */
+    template <typename Iterator>
+    size_type bulkLoad(Iterator first, Iterator last)
+    {
+        using Entry = typename std::iterator_traits<Iterator>::value_type;
+        return m_engine.bulkLoad(
+            first, last,
+            [](const Entry& entry) -> const key_type& { return entry.first; },
+            [](const Entry& entry) -> mapped_type { return entry.second; });
+    }
+
+    /**
+     * Calls `callback(key, value)` for every key in [lo, hi) in ascending
+     * order, the scan is weakly consistent (see SkipListEngine.h).
+     * @return Number of visited keys
+     */
+    template <typename Callback>
+    size_type rangeScan(const key_type& lo, const key_type& hi,
+                        Callback callback)
+    {
+        return m_engine.rangeScan(
+            lo, hi,
+            [&callback](const key_type& key, std::atomic<mapped_type>& value) {
+                callback(key, value.load());
+            });
+    }
+
+    /**
+     * Linearizable `rangeScan` of the keys, the values are read while they
+     * are visited. Requires an engine with snapshot support.
+     */
+    template <typename Callback>
+    size_type snapshotScan(const key_type& lo, const key_type& hi,
+                           Callback callback)
+    {
+        return m_engine.snapshotScan(
+            lo, hi,
+            [&callback](const key_type& key, std::atomic<mapped_type>& value) {
+                callback(key, value.load());
+            });
+    }
+
+    void clear()
+    {
+        m_engine.clear();
+    }
+
+    /**
+     * Iterators point to the key, the value is accessible by `mapped()`.
+     */
+    const_iterator begin()
+    {
+        return m_engine.begin();
+    }
+
+    const_iterator end()
+    {
+        return m_engine.end();
+    }
+
+    const_iterator lower_bound(const key_type& key)
+    {
+        return m_engine.lower_bound(key);
+    }
+
+    const_iterator upper_bound(const key_type& key)
+    {
+        return m_engine.upper_bound(key);
+    }
+
+  private:
+    Engine m_engine;
+};
+
+template <typename Key, typename Mapped, std::uint16_t MaximumHeight,
+          typename Allocator = HeapNodeAllocator,
+          typename HeightGenerator = HalfHeightGenerator,
+          typename Compare = std::less<Key>, typename Finger = NoFinger,
+          typename Validation = LockThenValidate,
+          typename SuccessorKeys = NoSuccessorKeys,
+          typename Prefetching = NoPrefetching>
+using LazySkipListMap = ConcurrentSkipListMap<
+    LazySkipListEngine<Key, Mapped, MaximumHeight, Allocator, HeightGenerator,
+                       Compare, Finger, Validation, SuccessorKeys,
+                       Prefetching>>;
+
+template <typename Key, typename Mapped, std::uint16_t MaximumHeight,
+          typename Reclamation = EpochBasedReclamation,
+          typename Allocator = HeapNodeAllocator,
+          typename HeightGenerator = HalfHeightGenerator,
+          typename Compare = std::less<Key>,
+          typename Snapshots = NoSnapshots, typename Finger = NoFinger,
+          typename Prefetching = NoPrefetching>
+using LockFreeSkipListMap = ConcurrentSkipListMap<
+    LockFreeSkipListEngine<Key, Mapped, MaximumHeight, Reclamation, Allocator,
+                           HeightGenerator, Compare, Snapshots, Finger,
+                           Prefetching>>;
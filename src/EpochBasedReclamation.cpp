@@ -0,0 +1,122 @@
+#include "EpochBasedReclamation.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+const std::uint64_t ActiveFlag = 1;
+}
+
+constexpr bool EpochBasedReclamation::RequiresValidation;
+
+EpochBasedReclamation::EpochBasedReclamation()
+    : m_epoch(0)
+{
+}
+
+EpochBasedReclamation::~EpochBasedReclamation()
+{
+    reclaimAll();
+}
+
+void EpochBasedReclamation::enter()
+{
+    auto& record = m_records.local();
+    if (record.nestingDepth++ == 0) {
+        const auto epoch = m_epoch.load(std::memory_order_relaxed);
+        // announcement must be visible before any shared node is read
+        record.announcedEpoch.store((epoch << 1) | ActiveFlag,
+                                    std::memory_order_seq_cst);
+    }
+}
+
+void EpochBasedReclamation::leave()
+{
+    auto& record = m_records.local();
+    assert(record.nestingDepth > 0);
+    if (--record.nestingDepth == 0) {
+        record.announcedEpoch.store(0, std::memory_order_release);
+    }
+}
+
+void EpochBasedReclamation::retire(void* pointer, Deleter deleter,
+                                   void* context)
+{
+    auto& record = m_records.local();
+    assert(record.nestingDepth > 0);
+
+    // the pointer is already unlinked, so every thread entering a critical
+    // region after this epoch value was published can not reach it anymore
+    const auto epoch = m_epoch.load(std::memory_order_seq_cst);
+    record.retired.push_back({pointer, deleter, context, epoch});
+
+    // batched, so the cost of scanning all thread records is amortized
+    if (record.retired.size() % ReclamationThreshold == 0) {
+        tryAdvanceEpoch();
+        reclaim(record);
+    }
+}
+
+std::uint64_t EpochBasedReclamation::generation()
+{
+    auto& record = m_records.local();
+    assert(record.nestingDepth > 0);
+
+    const auto announced =
+        record.announcedEpoch.load(std::memory_order_relaxed) >> 1;
+    // while the announcement is the current epoch, the epoch can advance
+    // once at most
+    return m_epoch.load(std::memory_order_seq_cst) == announced ? announced + 1
+                                                                : 0;
+}
+
+void EpochBasedReclamation::reclaimAll()
+{
+#ifndef NDEBUG
+    const auto* self = &m_records.local();
+#endif
+    m_records.forEach([&](ThreadRecord& record) {
+        assert((record.announcedEpoch.load() & ActiveFlag) == 0 ||
+               &record == self);
+        for (const auto& retired : record.retired) {
+            retired.deleter(retired.context, retired.pointer);
+        }
+        record.retired.clear();
+    });
+}
+
+bool EpochBasedReclamation::tryAdvanceEpoch()
+{
+    auto epoch = m_epoch.load(std::memory_order_seq_cst);
+
+    // the epoch can only advance if every active thread has observed it
+    bool allObserved = true;
+    m_records.forEach([&](const ThreadRecord& record) {
+        const auto announced =
+            record.announcedEpoch.load(std::memory_order_seq_cst);
+        if ((announced & ActiveFlag) && (announced >> 1) != epoch) {
+            allObserved = false;
+        }
+    });
+
+    return allObserved && m_epoch.compare_exchange_strong(epoch, epoch + 1);
+}
+
+void EpochBasedReclamation::reclaim(ThreadRecord& record)
+{
+    const auto epoch = m_epoch.load(std::memory_order_seq_cst);
+
+    // pointers retired two epochs ago are unreachable for all threads
+    const auto isSafe = [epoch](const RetiredPointer& retired) {
+        return retired.epoch + 2 <= epoch;
+    };
+
+    auto& retired = record.retired;
+    const auto firstPending =
+        std::partition(retired.begin(), retired.end(), isSafe);
+    for (auto it = retired.begin(); it != firstPending; ++it) {
+        it->deleter(it->context, it->pointer);
+    }
+    retired.erase(retired.begin(), firstPending);
+}
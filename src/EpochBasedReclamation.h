@@ -0,0 +1,140 @@
+#pragma once
+
+#include "PerThread.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+class EpochGuard;
+
+/**
+ * Epoch-based memory reclamation domain (Fraser, 2004).
+ *
+ * Threads enter a critical region before they dereference shared nodes and
+ * leave it afterwards. Unlinked nodes are handed to `retire` and freed in
+ * batches once the global epoch has advanced twice, i.e. once every thread
+ * which might still hold a reference has left its critical region.
+ *
+ * Each domain keeps one record per thread (announced epoch + retire list).
+ * Retired nodes which are still pending when the domain is destroyed are freed
+ * by the destructor, so the domain must not outlive the memory its deleters
+ * rely on.
+ */
+class EpochBasedReclamation
+{
+  public:
+    using Deleter = void (*)(void* context, void* pointer);
+    using Guard = EpochGuard;
+
+    /**
+     * Nodes reachable inside a critical region stay valid, they don't need to
+     * be re-validated after they have been read.
+     */
+    static constexpr bool RequiresValidation = false;
+
+  private:
+    struct RetiredPointer {
+        void* pointer;
+        Deleter deleter;
+        void* context;
+        std::uint64_t epoch;
+    };
+
+    struct ThreadRecord {
+        ThreadRecord()
+            : announcedEpoch(0)
+            , nestingDepth(0)
+        {
+        }
+
+        std::atomic<std::uint64_t> announcedEpoch; /**< epoch << 1 | active */
+        std::uint32_t nestingDepth;
+        std::vector<RetiredPointer> retired;
+    };
+
+  public:
+    EpochBasedReclamation();
+    ~EpochBasedReclamation();
+
+    EpochBasedReclamation(const EpochBasedReclamation&) = delete;
+    EpochBasedReclamation& operator=(const EpochBasedReclamation&) = delete;
+
+    /**
+     * Enters a critical region, nodes reachable from now on stay valid until
+     * the matching `leave`. Calls can be nested.
+     */
+    void enter();
+
+    void leave();
+
+    /**
+     * Hands an unlinked node to the domain, `deleter(context, pointer)` is
+     * called as soon as no thread can reference it anymore.
+     * Must be called from within a critical region.
+     */
+    void retire(void* pointer, Deleter deleter, void* context);
+
+    /**
+     * @return Generation of the calling thread's critical region, i.e. its
+     * epoch + 1 if the global epoch has not advanced since the region was
+     * entered, otherwise 0. Nodes which were reachable inside a region are
+     * still allocated in every later region with the same non-zero
+     * generation, as the epoch could not advance twice in between.
+     * Must be called from within a critical region.
+     */
+    std::uint64_t generation();
+
+    /**
+     * Frees all retired nodes immediately, requires that no other thread is
+     * inside a critical region of this domain.
+     */
+    void reclaimAll();
+
+  private:
+    bool tryAdvanceEpoch();
+    void reclaim(ThreadRecord& record);
+
+  private:
+    static const std::size_t ReclamationThreshold = 128;
+
+    std::atomic<std::uint64_t> m_epoch;
+    PerThread<ThreadRecord> m_records;
+};
+
+/**
+ * RAII helper which keeps the calling thread inside a critical region of the
+ * given domain for its lifetime.
+ */
+class EpochGuard
+{
+  public:
+    explicit EpochGuard(EpochBasedReclamation& domain)
+        : m_domain(domain)
+    {
+        m_domain.enter();
+    }
+
+    ~EpochGuard()
+    {
+        m_domain.leave();
+    }
+
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+
+    /**
+     * Epochs protect everything reachable, nothing to publish.
+     */
+    void protect(std::size_t, const void*)
+    {
+    }
+
+    std::uint64_t generation()
+    {
+        return m_domain.generation();
+    }
+
+  private:
+    EpochBasedReclamation& m_domain;
+};
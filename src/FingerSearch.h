@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "PerThread.h"
+
+/**
+ * Search path of the last operation of every thread of a concurrent list,
+ * the next search of the thread starts from it (finger search). Consecutive
+ * operations on nearby keys, e.g. ascending or descending inserts, then only
+ * walk the levels between both keys instead of descending from the head.
+ *
+ * The path is only reused if none of its nodes can have been freed in the
+ * meantime, which the guards of the reclamation policy tell by their
+ * `generation()`: nodes which were reachable under a guard are still
+ * allocated under every later guard with the same generation, unless it is 0.
+ * Nodes of the path might have been removed though, the lists check that a
+ * node is not marked before they start from it.
+ */
+template <typename Node, std::uint16_t MaximumHeight>
+class FingerDomain
+{
+  private:
+    struct Record {
+        std::array<Node*, MaximumHeight> path;
+        std::uint64_t generation = 0;
+    };
+
+  public:
+    /**
+     * @return Path of the calling thread, which is filled with `head` if its
+     * nodes might have been freed since the last operation; the caller
+     * stores its new search path into it
+     */
+    template <typename Guard>
+    std::array<Node*, MaximumHeight>&
+    path(std::array<Node*, MaximumHeight>&, Node* head, Guard& guard)
+    {
+        auto& record = m_records.local();
+        const auto generation = guard.generation();
+        if (generation != record.generation || generation == 0) {
+            record.path.fill(head);
+            record.generation = generation;
+        }
+        return record.path;
+    }
+
+  private:
+    PerThread<Record> m_records;
+};
+
+/**
+ * Search policy of the lists which always descend from the head.
+ */
+struct NoFinger {
+    static constexpr bool Enabled = false;
+
+    template <typename Node, std::uint16_t MaximumHeight>
+    class Domain
+    {
+      public:
+        /**
+         * @return `local`, the search path of a single operation
+         */
+        template <typename Guard>
+        std::array<Node*, MaximumHeight>&
+        path(std::array<Node*, MaximumHeight>& local, Node*, Guard&)
+        {
+            return local;
+        }
+    };
+};
+
+/**
+ * Search policy of the lists which start every search from the search path
+ * of the previous operation of the calling thread, see FingerDomain. The
+ * sequential list keeps a single path.
+ */
+struct ThreadFinger {
+    static constexpr bool Enabled = true;
+
+    template <typename Node, std::uint16_t MaximumHeight>
+    using Domain = FingerDomain<Node, MaximumHeight>;
+};
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "PerThread.h"
+#include "SequentialSkipList.h"
+#include "SpinLock.h"
+
+/**
+ * SequentialSkipList shared by flat combining (Hendler et al., 2010).
+ *
+ * A thread publishes its `insert`, `remove` or `contains` in its own request
+ * slot and waits until the request has been applied. Whichever waiting thread
+ * acquires the lock becomes the combiner: it collects all pending requests,
+ * sorts them by value and applies them with a single sweep through the list
+ * (see SequentialSkipList::Sweep), so that the lock changes hands once per
+ * batch instead of once per operation. All requests of a batch are pending
+ * at the same time, so any order of them is linearizable.
+ *
+ * The other operations lock the list and run directly on it.
+ */
+template <typename T, std::uint16_t MaximumHeight>
+class FlatCombiningSkipList final : public SkipList<T>
+{
+  public:
+    static_assert(MaximumHeight > 0, "Maximum height must be greater than 0");
+
+    using value_type = typename SkipList<T>::value_type;
+    using reference = typename SkipList<T>::reference;
+    using const_reference = typename SkipList<T>::const_reference;
+    using pointer = typename SkipList<T>::pointer;
+    using const_pointer = typename SkipList<T>::const_pointer;
+    using difference_type = typename SkipList<T>::difference_type;
+    using size_type = typename SkipList<T>::size_type;
+
+  private:
+    using List = SequentialSkipList<T, MaximumHeight>;
+
+    enum class Operation : std::uint8_t { Insert, Remove, Contains };
+
+    enum class State : std::uint8_t { Empty, Pending, Done };
+
+    // pauses a thread waits for its request before it yields
+    static const std::uint32_t MaximumSpins = 1 << 12;
+
+    /**
+     * Request slot of a thread. The owner writes `operation` and `value`
+     * before it publishes the request by `state`, the combiner writes
+     * `result` before it marks the request as done. The slots are small heap
+     * allocations of PerThread, the padding keeps the fields of two slots
+     * on different cache lines.
+     */
+    struct Request {
+        char padding[64]; /**< no false sharing with other slots */
+        std::atomic<State> state{State::Empty};
+        Operation operation = Operation::Contains;
+        value_type value = value_type();
+        bool result = false;
+    };
+
+  public:
+    FlatCombiningSkipList()
+        : m_lock()
+        , m_list()
+        , m_requests()
+        , m_batch()
+        , m_compare()
+    {
+    }
+
+    bool empty() override
+    {
+        std::lock_guard<TTASLock> lock(m_lock);
+        return m_list.empty();
+    }
+
+    size_type size() override
+    {
+        std::lock_guard<TTASLock> lock(m_lock);
+        return m_list.size();
+    }
+
+    bool insert(const_reference value) override
+    {
+        return apply(Operation::Insert, value);
+    }
+
+    bool remove(const_reference value) override
+    {
+        return apply(Operation::Remove, value);
+    }
+
+    bool contains(const_reference value) override
+    {
+        return apply(Operation::Contains, value);
+    }
+
+    size_type insertBatch(const_pointer first, const_pointer last,
+                          bool* results) override
+    {
+        std::lock_guard<TTASLock> lock(m_lock);
+        return m_list.insertBatch(first, last, results);
+    }
+
+    size_type removeBatch(const_pointer first, const_pointer last,
+                          bool* results) override
+    {
+        std::lock_guard<TTASLock> lock(m_lock);
+        return m_list.removeBatch(first, last, results);
+    }
+
+    size_type containsBatch(const_pointer first, const_pointer last,
+                            bool* results) override
+    {
+        std::lock_guard<TTASLock> lock(m_lock);
+        return m_list.containsBatch(first, last, results);
+    }
+
+    size_type bulkLoad(const_pointer first, const_pointer last) override
+    {
+        std::lock_guard<TTASLock> lock(m_lock);
+        return m_list.bulkLoad(first, last);
+    }
+
+    size_type
+    rangeScan(const_reference lo, const_reference hi,
+              const std::function<void(const_reference)>& callback) override
+    {
+        std::lock_guard<TTASLock> lock(m_lock);
+        return m_list.rangeScan(lo, hi, callback);
+    }
+
+    void clear() override
+    {
+        std::lock_guard<TTASLock> lock(m_lock);
+        m_list.clear();
+    }
+
+  private:
+    /**
+     * Publishes the request and waits until it has been applied, combines
+     * the pending requests of all threads if the lock is free.
+     */
+    bool apply(Operation operation, const_reference value)
+    {
+        auto& request = m_requests.local();
+        request.operation = operation;
+        request.value = value;
+        request.state.store(State::Pending, std::memory_order_release);
+
+        // the combiner reports on the request slot, so waiting is spinning
+        // on an own cache line; yield only once the combiner takes much
+        // longer than a pass (e.g. it has been preempted)
+        std::uint32_t spins = 0;
+        while (request.state.load(std::memory_order_acquire) != State::Done) {
+            if (m_lock.try_lock()) {
+                combine();
+                m_lock.unlock();
+            } else if (spins < MaximumSpins) {
+                ++spins;
+                spinPause();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+
+        request.state.store(State::Empty, std::memory_order_relaxed);
+        return request.result;
+    }
+
+    /**
+     * Applies all pending requests in ascending order of their values, must
+     * be called with the lock held.
+     */
+    void combine()
+    {
+        m_batch.clear();
+        m_requests.forEach([this](Request& request) {
+            if (request.state.load(std::memory_order_acquire) ==
+                State::Pending) {
+                m_batch.push_back(&request);
+            }
+        });
+        std::sort(m_batch.begin(), m_batch.end(),
+                  [this](const Request* lhs, const Request* rhs) {
+                      return m_compare(lhs->value, rhs->value);
+                  });
+
+        typename List::Sweep sweep(m_list);
+        for (auto* request : m_batch) {
+            switch (request->operation) {
+            case Operation::Insert:
+                request->result = sweep.insert(request->value);
+                break;
+            case Operation::Remove:
+                request->result = sweep.remove(request->value);
+                break;
+            case Operation::Contains:
+                request->result = sweep.contains(request->value);
+                break;
+            }
+            request->state.store(State::Done, std::memory_order_release);
+        }
+    }
+
+  private:
+    TTASLock m_lock;
+    List m_list;                   // guarded by m_lock
+    PerThread<Request> m_requests;
+    std::vector<Request*> m_batch; // guarded by m_lock, reused by combine
+    std::less<T> m_compare;
+};
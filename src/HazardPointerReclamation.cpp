@@ -0,0 +1,81 @@
+#include "HazardPointerReclamation.h"
+
+#include <algorithm>
+#include <cassert>
+
+constexpr bool HazardPointerReclamation::RequiresValidation;
+constexpr std::size_t HazardPointerReclamation::MaximumHazardsPerThread;
+const std::size_t HazardPointerReclamation::ReclamationThreshold;
+
+HazardPointerReclamation::ThreadRecord::ThreadRecord()
+    : usedHazards(0)
+{
+    for (auto& hazard : hazards) {
+        hazard.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+HazardPointerReclamation::HazardPointerReclamation()
+{
+}
+
+HazardPointerReclamation::~HazardPointerReclamation()
+{
+    reclaimAll();
+}
+
+void HazardPointerReclamation::retire(void* pointer, Deleter deleter,
+                                      void* context)
+{
+    auto& record = m_records.local();
+    record.retired.push_back({pointer, deleter, context});
+
+    // scan once the retire list clearly outnumbers all published hazards, so
+    // each scan frees at least half of the list
+    const auto publishedHazards =
+        m_records.size() *
+        record.usedHazards.load(std::memory_order_relaxed);
+    if (record.retired.size() >=
+        std::max(ReclamationThreshold, 2 * publishedHazards)) {
+        scan(record);
+    }
+}
+
+void HazardPointerReclamation::reclaimAll()
+{
+    m_records.forEach([](ThreadRecord& record) {
+        for (const auto& retired : record.retired) {
+            retired.deleter(retired.context, retired.pointer);
+        }
+        record.retired.clear();
+    });
+}
+
+void HazardPointerReclamation::scan(ThreadRecord& record)
+{
+    // snapshot all currently published hazards
+    std::vector<const void*> hazards;
+    m_records.forEach([&hazards](const ThreadRecord& other) {
+        const auto usedHazards = other.usedHazards.load();
+        for (std::size_t slot = 0; slot < usedHazards; ++slot) {
+            const auto* hazard = other.hazards[slot].load();
+            if (hazard != nullptr) {
+                hazards.push_back(hazard);
+            }
+        }
+    });
+    std::sort(hazards.begin(), hazards.end());
+
+    const auto isProtected = [&hazards](const RetiredPointer& retired) {
+        return std::binary_search(hazards.begin(), hazards.end(),
+                                  retired.pointer);
+    };
+
+    auto& retired = record.retired;
+    const auto firstUnprotected =
+        std::partition(retired.begin(), retired.end(), isProtected);
+    for (auto it = firstUnprotected; it != retired.end(); ++it) {
+        it->deleter(it->context, it->pointer);
+    }
+    retired.erase(firstUnprotected, retired.end());
+}
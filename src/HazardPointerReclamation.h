@@ -0,0 +1,133 @@
+#pragma once
+
+#include "PerThread.h"
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+class HazardPointerGuard;
+
+/**
+ * Hazard pointer based memory reclamation domain (Michael, 2004).
+ *
+ * Before a thread dereferences a shared node it publishes the node in one of
+ * its hazard slots and validates that the node is still reachable. Retired
+ * nodes are freed in batches, skipping all nodes which are currently
+ * published by any thread. In contrast to epochs, a stalled thread only
+ * prevents the nodes it actually protects from being freed, so the number of
+ * unreclaimed nodes stays bounded.
+ *
+ * Retired nodes which are still pending when the domain is destroyed are freed
+ * by the destructor.
+ */
+class HazardPointerReclamation
+{
+  public:
+    using Deleter = void (*)(void* context, void* pointer);
+    using Guard = HazardPointerGuard;
+
+    /**
+     * Protected nodes have to be validated after they have been published,
+     * the publication might have raced with the removal of the node.
+     */
+    static constexpr bool RequiresValidation = true;
+
+    /**
+     * Enough hazards for a lock-free skip list with towers of up to 64 levels
+     * (predecessor and successor of each level + 2 for the traversal + 2 for
+     * range scans).
+     */
+    static constexpr std::size_t MaximumHazardsPerThread = 2 * 64 + 4;
+
+  private:
+    struct RetiredPointer {
+        void* pointer;
+        Deleter deleter;
+        void* context;
+    };
+
+    struct ThreadRecord {
+        ThreadRecord();
+
+        std::array<std::atomic<const void*>, MaximumHazardsPerThread> hazards;
+        std::atomic<std::size_t> usedHazards; /**< highest used slot + 1 */
+        std::vector<RetiredPointer> retired;
+    };
+
+  public:
+    HazardPointerReclamation();
+    ~HazardPointerReclamation();
+
+    HazardPointerReclamation(const HazardPointerReclamation&) = delete;
+    HazardPointerReclamation&
+    operator=(const HazardPointerReclamation&) = delete;
+
+    /**
+     * Hands an unlinked node to the domain, `deleter(context, pointer)` is
+     * called as soon as no hazard pointer references it anymore.
+     */
+    void retire(void* pointer, Deleter deleter, void* context);
+
+    /**
+     * Frees all retired nodes immediately, requires that no other thread
+     * accesses nodes of this domain anymore.
+     */
+    void reclaimAll();
+
+  private:
+    friend class HazardPointerGuard;
+
+    void scan(ThreadRecord& record);
+
+  private:
+    static const std::size_t ReclamationThreshold = 128;
+
+    PerThread<ThreadRecord> m_records;
+};
+
+/**
+ * Gives access to the hazard slots of the calling thread for the duration of
+ * an operation. Published hazards are cleared when the guard is destroyed.
+ */
+class HazardPointerGuard
+{
+  public:
+    explicit HazardPointerGuard(HazardPointerReclamation& domain)
+        : m_record(domain.m_records.local())
+        , m_usedHazards(0)
+    {
+    }
+
+    ~HazardPointerGuard()
+    {
+        for (std::size_t slot = 0; slot < m_usedHazards; ++slot) {
+            m_record.hazards[slot].store(nullptr, std::memory_order_release);
+        }
+    }
+
+    HazardPointerGuard(const HazardPointerGuard&) = delete;
+    HazardPointerGuard& operator=(const HazardPointerGuard&) = delete;
+
+    /**
+     * Publishes `pointer` in the given slot, the caller has to re-validate
+     * that the node is still reachable before dereferencing it.
+     */
+    void protect(std::size_t slot, const void* pointer)
+    {
+        assert(slot < HazardPointerReclamation::MaximumHazardsPerThread);
+        if (slot >= m_usedHazards) {
+            m_usedHazards = slot + 1;
+            if (m_usedHazards > m_record.usedHazards.load()) {
+                m_record.usedHazards.store(m_usedHazards);
+            }
+        }
+        m_record.hazards[slot].store(pointer, std::memory_order_seq_cst);
+    }
+
+  private:
+    HazardPointerReclamation::ThreadRecord& m_record;
+    std::size_t m_usedHazards;
+};
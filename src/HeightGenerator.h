@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <random>
+
+/**
+ * Thread-local wyrand generator (Wang Yi), seeded once per thread.
+ */
+class ThreadLocalRandom
+{
+  public:
+    static std::uint64_t next()
+    {
+        static thread_local std::uint64_t state = seed();
+
+        state += 0xa0761d6478bd642fULL;
+        const auto product = static_cast<unsigned __int128>(state) *
+                             (state ^ 0xe7037ed1a0b428dbULL);
+        return static_cast<std::uint64_t>(product >> 64) ^
+               static_cast<std::uint64_t>(product);
+    }
+
+  private:
+    static std::uint64_t seed()
+    {
+        std::random_device randomDevice;
+        return (static_cast<std::uint64_t>(randomDevice()) << 32) ^
+               randomDevice();
+    }
+};
+
+/**
+ * Height policy with branching probability p = 1 / 2^Log2InverseProbability,
+ * i.e. a node reaches the next level with probability p.
+ *
+ * Each level takes `Log2InverseProbability` random bits, so the height is the
+ * number of trailing zeros of a random number divided by that width.
+ */
+template <unsigned Log2InverseProbability>
+class GeometricHeightGenerator
+{
+  public:
+    static_assert(Log2InverseProbability > 0 && Log2InverseProbability < 64,
+                  "Branching probability must be in range ]0..1[");
+
+    /**
+     * @return Random height in range [0..MaximumHeight[
+     */
+    template <std::uint16_t MaximumHeight>
+    static std::uint16_t generate()
+    {
+        // the guard bit limits the count to 63 if all random bits are zero
+        const auto random = ThreadLocalRandom::next() | (1ULL << 63);
+        const auto height = static_cast<std::uint16_t>(
+            __builtin_ctzll(random) / Log2InverseProbability);
+        return std::min<std::uint16_t>(height, MaximumHeight - 1);
+    }
+};
+
+/**
+ * p = 1/2, the classic coin flip per level.
+ */
+using HalfHeightGenerator = GeometricHeightGenerator<1>;
+
+/**
+ * p = 1/4, half the pointers per node of p = 1/2 at slightly longer searches.
+ */
+using QuarterHeightGenerator = GeometricHeightGenerator<2>;
+
+/**
+ * p = 1/e, minimizes the expected search cost (Pugh, 1990). Not a power of
+ * two, so each level compares 32 random bits against the threshold p * 2^32.
+ */
+class InverseEHeightGenerator
+{
+  public:
+    /**
+     * @return Random height in range [0..MaximumHeight[
+     */
+    template <std::uint16_t MaximumHeight>
+    static std::uint16_t generate()
+    {
+        const std::uint32_t threshold = 1580030169; // 2^32 / e
+
+        std::uint16_t height = 0;
+        while (height < MaximumHeight - 1) {
+            const auto random = ThreadLocalRandom::next();
+            if (static_cast<std::uint32_t>(random) >= threshold) {
+                break;
+            }
+            ++height;
+            if (height == MaximumHeight - 1 ||
+                static_cast<std::uint32_t>(random >> 32) >= threshold) {
+                break;
+            }
+            ++height;
+        }
+
+        assert(height < MaximumHeight);
+        return height;
+    }
+};
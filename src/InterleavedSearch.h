@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Prefetching.h"
+#include "SkipListStatistics.h"
+
+/**
+ * Looks up the unordered keys [first, last) by `GroupSize` searches at once
+ * (asynchronous memory access chaining, Kocberber et al., 2015). A single
+ * search stalls on every node it loads, the next step depends on it. Here
+ * each search prefetches the node it compares next and yields to the other
+ * searches of the group, whose prefetches overlap with it, so that the node
+ * has arrived by the time the search continues. Pays off once the list
+ * exceeds the caches.
+ *
+ * `search` adapts the list and provides:
+ *
+ *  - `key_type` and `Node`, which has a tower `next` (see Prefetching.h)
+ *  - `Node* head()` and `std::int32_t topLevel()`, where the searches start
+ *  - `Node* next(Node* node, level)`: successor of `node` on `level`
+ *  - `bool isRemoved(Node* node, level)`: true if `node` must be skipped,
+ *    e.g. because its link on `level` is marked for removal
+ *  - `bool isBefore(Node* node, key)`: true if `node` precedes `key`
+ *  - `bool found(Node* node, key)`: called on the bottom level with the first
+ *    node which doesn't precede `key`, returns whether it holds the key
+ *
+ * The caller must protect all nodes from reclamation meanwhile.
+ *
+ * @return Number of found keys, `results[i]` receives the result of
+ * `first[i]`
+ */
+template <std::size_t GroupSize = 8, typename Search>
+std::size_t interleavedSearch(Search& search,
+                              const typename Search::key_type* first,
+                              const typename Search::key_type* last,
+                              bool* results)
+{
+    using Key = typename Search::key_type;
+    using Node = typename Search::Node;
+
+    struct Lookup {
+        const Key* key;
+        Node* pred;
+        Node* curr; // prefetched, compared by the next step
+        std::int32_t level;
+    };
+
+    const Key* pending = first;
+    auto start = [&](Lookup& lookup) -> bool {
+        if (pending == last) {
+            return false;
+        }
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupStart();
+#endif
+        lookup.key = pending++;
+        lookup.pred = search.head();
+        lookup.level = search.topLevel();
+        lookup.curr = search.next(lookup.pred, lookup.level);
+        SuccessorPrefetching::node(lookup.curr, lookup.level);
+        return true;
+    };
+
+    std::array<Lookup, GroupSize> lookups;
+    std::size_t active = 0;
+    while (active < GroupSize && start(lookups[active])) {
+        ++active;
+    }
+
+    std::size_t count = 0;
+    while (active > 0) {
+        for (std::size_t i = 0; i < active;) {
+            // one step of a search, ends with the prefetch of its next node
+            Lookup& lookup = lookups[i];
+            if (search.isRemoved(lookup.curr, lookup.level)) {
+                lookup.curr = search.next(lookup.curr, lookup.level);
+                SuccessorPrefetching::node(lookup.curr, lookup.level);
+                ++i;
+                continue;
+            }
+
+            if (search.isBefore(lookup.curr, *lookup.key)) {
+                lookup.pred = lookup.curr;
+            } else if (lookup.level > 0) {
+                --lookup.level;
+            } else {
+                const bool found = search.found(lookup.curr, *lookup.key);
+#ifdef COLLECT_STATISTICS
+                SkipListStatistics::threadLocalInstance().lookupDone();
+#endif
+                results[lookup.key - first] = found;
+                count += found ? 1 : 0;
+                if (!start(lookup)) {
+                    // the last search takes the slot of the finished one
+                    lookup = lookups[--active];
+                    continue;
+                }
+                ++i;
+                continue;
+            }
+            lookup.curr = search.next(lookup.pred, lookup.level);
+            SuccessorPrefetching::node(lookup.curr, lookup.level);
+            ++i;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+/**
+ * Arena of key types which are stored inline in the nodes.
+ */
+struct NoKeyArena {
+};
+
+/**
+ * Decides where the lists keep the contents of their keys.
+ *
+ * The key of a node is created by `store(arena, key)`, which may copy external
+ * data of the key (e.g. the characters of a string) into the arena of the
+ * list. `release(arena, key)` is called before the node is destroyed, unless
+ * the list drops all nodes at once, which is followed by `releaseAll(arena)`.
+ * The primary template copies the key into the node and doesn't need an
+ * arena.
+ */
+template <typename Key>
+struct KeyStorage {
+    using Arena = NoKeyArena;
+
+    static const Key& store(Arena&, const Key& key)
+    {
+        return key;
+    }
+
+    static void release(Arena&, const Key&)
+    {
+    }
+
+    static void releaseAll(Arena&)
+    {
+    }
+};
@@ -3,95 +3,418 @@
 #include <array>
 #include <atomic>
 #include <cassert>
-#include <limits>
+#include <functional>
+#include <memory>
 #include <mutex>
-#include <random>
-
-#include "SkipList.h"
+#include <type_traits>
+#include <vector>
+
+#include "BulkLoad.h"
+#include "EpochBasedReclamation.h"
+#include "FingerSearch.h"
+#include "HeightGenerator.h"
+#include "InterleavedSearch.h"
+#include "KeyStorage.h"
+#include "NodeAllocator.h"
+#include "NodeTower.h"
+#include "Prefetching.h"
+#include "ShardedCounter.h"
+#include "SpinLock.h"
+#include "SkipListEngine.h"
 #include "SkipListStatistics.h"
-
-template <typename T, std::uint16_t MaximumHeight>
-class LazySkipList final : public SkipList<T>
+#include "SuccessorKeys.h"
+#include "TopLevelHint.h"
+
+/**
+ * Lazy lock-based skip list (Herlihy et al., 2006) which maps each key to a
+ * value, see SkipListEngine.h for the interface.
+ *
+ * @tparam Mapped Trivially copyable value, replaced and updated atomically
+ * @tparam MaximumHeight Number of levels of the head. The searches start at
+ * the highest level in use (see TopLevelHint), so a maximum which suits the
+ * largest lists doesn't slow down small ones.
+ * @tparam Allocator Provides the memory of the nodes, HeapNodeAllocator or
+ * SlabNodeAllocator
+ * @tparam HeightGenerator Policy which draws the height of new nodes, e.g.
+ * HalfHeightGenerator, QuarterHeightGenerator or InverseEHeightGenerator
+ * @tparam Compare Strict weak ordering of the keys, head and sentinel are
+ * compared by address and don't need a smallest or largest key
+ * @tparam Finger NoFinger or ThreadFinger, which starts every search from
+ * the search path of the previous operation of the thread
+ * @tparam Validation LockThenValidate or OptimisticValidation, which
+ * validates the predecessors by the versions of their locks (OPTIK)
+ * @tparam SuccessorKeys NoSuccessorKeys or CachedSuccessorKeys, which stores
+ * the key of the successor in every tower slot. A concurrent update can tear
+ * the pointer and key of a slot apart, so the cached keys only decide when
+ * the search descends: moves to the right and the bottom level are checked
+ * against the keys of the nodes.
+ * @tparam Prefetching NoPrefetching or SuccessorPrefetching, which prefetches
+ * both nodes a search step may continue with
+ */
+template <typename Key, typename Mapped, std::uint16_t MaximumHeight,
+          typename Allocator = HeapNodeAllocator,
+          typename HeightGenerator = HalfHeightGenerator,
+          typename Compare = std::less<Key>, typename Finger = NoFinger,
+          typename Validation = LockThenValidate,
+          typename SuccessorKeys = NoSuccessorKeys,
+          typename Prefetching = NoPrefetching>
+class LazySkipListEngine
 {
   public:
     static_assert(MaximumHeight > 0, "Maximum height must be greater than 0");
+    static_assert(std::is_trivially_copyable<Mapped>::value,
+                  "Mapped must be trivially copyable");
+    static_assert(!SuccessorKeys::Enabled ||
+                      std::is_trivially_copyable<Key>::value,
+                  "Only trivially copyable keys can be cached in links");
 
-    using value_type = typename SkipList<T>::value_type;
-    using reference = typename SkipList<T>::reference;
-    using const_reference = typename SkipList<T>::const_reference;
-    using pointer = typename SkipList<T>::pointer;
-    using const_pointer = typename SkipList<T>::const_pointer;
-    using difference_type = typename SkipList<T>::difference_type;
-    using size_type = typename SkipList<T>::size_type;
+    using key_type = Key;
+    using mapped_type = Mapped;
+    using size_type = std::size_t;
 
   private:
+    struct Node;
+
+    using Link = typename SuccessorKeys::template Link<Node, Key, Node*>;
+
     struct Node {
-        Node(const_reference value, std::uint16_t height)
-            : value(value)
+        Node(const key_type& key, std::uint16_t height)
+            : key(key)
             , height(height)
+            , mapped()
+            , next(height)
         {
         }
 
-        ~Node()
-        {
-        }
-
-        const value_type value;
-        std::array<Node*, MaximumHeight> next;
+        const key_type key;
         const std::uint16_t height;
-        std::recursive_mutex mutex;
+        typename Validation::Lock lock;
         volatile bool marked = false;
         volatile bool fullyLinked = false;
+        std::atomic<mapped_type> mapped;
+        NodeTower<Link> next; // must be the last member
     };
 
+    using Storage = KeyStorage<key_type>;
+    using Guard = EpochGuard;
+    using Version = typename Validation::Version;
+    using Lock = typename Validation::Lock;
+
+    // the allocator can drop all nodes at once, no need to visit them
+    static constexpr bool ReleasesAllNodesAtOnce =
+        Allocator::ReleasesAllOnDestruction &&
+        std::is_trivially_destructible<Node>::value;
+
   public:
-    LazySkipList()
-        : m_head(
-              new Node(std::numeric_limits<value_type>::min(), MaximumHeight))
-        , m_sentinel(
-              new Node(std::numeric_limits<value_type>::max(), MaximumHeight))
-        , m_size(0)
+    using const_iterator = EngineIterator<LazySkipListEngine, Node>;
+
+  public:
+    LazySkipListEngine()
+        : m_head(createTowerNode<Node>(key_type(), MaximumHeight - 1))
+        , m_sentinel(createTowerNode<Node>(key_type(), MaximumHeight - 1))
+        , m_topLevel()
+        , m_size()
+        , m_compare()
+        , m_keyArena()
+        , m_allocator()
+        , m_reclamation()
+        , m_finger()
     {
-        m_head->next.fill(m_sentinel); // connect head with sentinel
-        m_sentinel->next.fill(nullptr);
+        for (std::uint16_t level = 0; level < MaximumHeight; ++level) {
+            link(m_head, level, m_sentinel); // connect head with sentinel
+            link(m_sentinel, level, nullptr);
+        }
     }
 
-    ~LazySkipList() override
+    ~LazySkipListEngine()
     {
-        for (auto* current = m_head; current != nullptr;) {
-            auto* next = current->next[0];
-            delete current;
-            current = next;
+        // pending nodes must be freed before the allocator drops them
+        m_reclamation.reclaimAll();
+        destroyNodes(std::integral_constant<bool, ReleasesAllNodesAtOnce>());
+
+        // head and sentinel are not part of the allocator
+        destroyTowerNode(m_head);
+        destroyTowerNode(m_sentinel);
+    }
+
+    bool empty()
+    {
+        return m_size.value() == 0;
+    }
+
+    size_type size()
+    {
+        return m_size.value();
+    }
+
+    size_type sizeEstimate()
+    {
+        return m_size.estimate();
+    }
+
+    /**
+     * @return Highest level on which a node may be linked, where the searches
+     * start (see TopLevelHint)
+     */
+    std::uint16_t topLevel() const
+    {
+        return m_topLevel.load();
+    }
+
+    template <typename MakeMapped, typename VisitExisting>
+    bool insert(const key_type& key, MakeMapped makeMapped,
+                VisitExisting visitExisting)
+    {
+        EpochGuard guard(m_reclamation);
+        std::array<Node*, MaximumHeight> path;
+        auto& predecessors = m_finger.path(path, m_head, guard);
+        std::array<Node*, MaximumHeight> successors;
+        return insert(key, makeMapped, visitExisting, predecessors,
+                      successors, Finger::Enabled);
+    }
+
+    bool remove(const key_type& key)
+    {
+        EpochGuard guard(m_reclamation);
+        std::array<Node*, MaximumHeight> path;
+        auto& predecessors = m_finger.path(path, m_head, guard);
+        std::array<Node*, MaximumHeight> successors;
+        return remove(key, predecessors, successors, Finger::Enabled);
+    }
+
+    template <typename Visit>
+    bool visit(const key_type& key, Visit visit)
+    {
+        EpochGuard guard(m_reclamation);
+        std::array<Node*, MaximumHeight> path;
+        auto& predecessors = m_finger.path(path, m_head, guard);
+        std::array<Node*, MaximumHeight> successors;
+        return this->visit(key, visit, predecessors, successors,
+                           Finger::Enabled);
+    }
+
+    /**
+     * Batched `insert` of the sorted range [first, last), see
+     * SkipList::insertBatch.
+     */
+    template <typename MakeMapped, typename VisitExisting>
+    size_type insertBatch(const key_type* first, const key_type* last,
+                          MakeMapped makeMapped, VisitExisting visitExisting,
+                          bool* results)
+    {
+        EpochGuard guard(m_reclamation);
+
+        std::array<Node*, MaximumHeight> predecessors;
+        std::array<Node*, MaximumHeight> successors;
+        predecessors.fill(m_head);
+        size_type count = 0;
+        for (; first != last; ++first, ++results) {
+            *results = insert(*first, makeMapped, visitExisting, predecessors,
+                              successors, true);
+            count += *results ? 1 : 0;
+        }
+        return count;
+    }
+
+    size_type removeBatch(const key_type* first, const key_type* last,
+                          bool* results)
+    {
+        EpochGuard guard(m_reclamation);
+
+        std::array<Node*, MaximumHeight> predecessors;
+        std::array<Node*, MaximumHeight> successors;
+        predecessors.fill(m_head);
+        size_type count = 0;
+        for (; first != last; ++first, ++results) {
+            *results = remove(*first, predecessors, successors, true);
+            count += *results ? 1 : 0;
         }
+        return count;
     }
 
-    bool empty() override
+    template <typename Visit>
+    size_type visitBatch(const key_type* first, const key_type* last,
+                         Visit visit, bool* results)
+    {
+        EpochGuard guard(m_reclamation);
+
+        std::array<Node*, MaximumHeight> predecessors;
+        std::array<Node*, MaximumHeight> successors;
+        predecessors.fill(m_head);
+        size_type count = 0;
+        for (; first != last; ++first, ++results) {
+            *results = this->visit(*first, visit, predecessors, successors,
+                                   true);
+            count += *results ? 1 : 0;
+        }
+        return count;
+    }
+
+    /**
+     * `visit` of the unordered keys [first, last), whose searches are
+     * interleaved to overlap their cache misses, see SkipList::containsMany.
+     */
+    template <typename Visit>
+    size_type visitMany(const key_type* first, const key_type* last,
+                        Visit visit, bool* results)
     {
-        return m_size == 0;
+        EpochGuard guard(m_reclamation);
+        InterleavedVisit<Visit> search(*this, visit);
+        return interleavedSearch(search, first, last, results);
     }
 
-    size_type size() override
+    /**
+     * Inserts the sorted range [first, last) with the keys `getKey(*it)` and
+     * the values `getMapped(*it)`, see SkipList::bulkLoad. Must not run
+     * concurrently with other operations.
+     * @return Number of inserted keys
+     */
+    template <typename Iterator, typename GetKey, typename GetMapped>
+    size_type bulkLoad(Iterator first, Iterator last, GetKey getKey,
+                       GetMapped getMapped)
     {
-        return m_size;
+        if (m_head->next[0] != m_sentinel) {
+            size_type count = 0;
+            for (; first != last; ++first) {
+                const mapped_type mapped = getMapped(*first);
+                if (insert(getKey(*first), ConstantMapped<mapped_type>(mapped),
+                           IgnoreMapped())) {
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        const auto result =
+            BulkLoader<Node, MaximumHeight, HeightGenerator>::load(
+                m_head, m_sentinel, first, last, getKey, m_compare,
+                [&](Iterator current, std::uint16_t height) {
+                    auto* node = createTowerNode<Node>(
+                        m_allocator,
+                        Storage::store(m_keyArena, getKey(*current)), height);
+                    node->mapped.store(getMapped(*current),
+                                       std::memory_order_relaxed);
+                    node->fullyLinked = true;
+                    return node;
+                },
+                [](Node* pred, std::uint16_t level, Node* succ) {
+                    link(pred, level, succ);
+                });
+        m_topLevel.raise(result.height);
+        m_size.add(result.count);
+        return result.count;
     }
 
-    bool insert(const_reference value) override
+    template <typename Visit>
+    size_type rangeScan(const key_type& lo, const key_type& hi, Visit visit)
     {
 #ifdef COLLECT_STATISTICS
-        SkipListStatistics::threadLocalInstance().insertionStart();
+        SkipListStatistics::threadLocalInstance().lookupStart();
 #endif
+        EpochGuard guard(m_reclamation);
 
-        const auto newHeight = randomHeight();
         std::array<Node*, MaximumHeight> predecessors;
         std::array<Node*, MaximumHeight> successors;
+        find(lo, predecessors, successors);
 
+        size_type count = 0;
+        for (auto* node = skipRemoved(successors[0]); isBefore(node, hi);
+             node = nextNode(node)) {
+            visit(node->key, node->mapped);
+            ++count;
+        }
+
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupDone();
+#endif
+        return count;
+    }
+
+    const_iterator begin()
+    {
+        auto guard = createGuard();
+        return const_iterator(this, nextNode(m_head), std::move(guard));
+    }
+
+    const_iterator end()
+    {
+        return const_iterator(this, m_sentinel, nullptr);
+    }
+
+    const_iterator lower_bound(const key_type& key)
+    {
+        return bound<false>(key);
+    }
+
+    const_iterator upper_bound(const key_type& key)
+    {
+        return bound<true>(key);
+    }
+
+    void clear()
+    {
+        // TODO not linearizable?
+        EpochGuard guard(m_reclamation);
+        std::lock_guard<Lock> lock(m_head->lock);
+
+        // mark all nodes (expect of head and sentinel), nodes which have been
+        // marked by a concurrent remove are retired by the removing thread
+        std::vector<Node*> markedNodes;
+        for (Node* current = m_head->next[0]; current != m_sentinel;
+             current = current->next[0]) {
+            while (not current->fullyLinked) {
+            }
+            std::lock_guard<Lock> currentLock(current->lock);
+            if (not current->marked) {
+                current->marked = true;
+                markedNodes.push_back(current);
+            }
+        }
+
+        // fully re-connect head with sentinel
+        for (std::uint16_t level = 0; level < MaximumHeight; ++level) {
+            link(m_head, level, m_sentinel);
+        }
+
+        m_size.add(-static_cast<std::int64_t>(markedNodes.size()));
+
+        for (auto* node : markedNodes) {
+            m_reclamation.retire(node, &reclaimNode, this);
+        }
+    }
+
+  private:
+    friend const_iterator;
+
+    /**
+     * @param fromPredecessors Continue the search from `predecessors`, which
+     * hold the search path of a preceding key (see `find`)
+     */
+    template <typename MakeMapped, typename VisitExisting>
+    bool insert(const key_type& key, MakeMapped makeMapped,
+                VisitExisting visitExisting,
+                std::array<Node*, MaximumHeight>& predecessors,
+                std::array<Node*, MaximumHeight>& successors,
+                bool fromPredecessors)
+    {
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().insertionStart();
+#endif
+        const auto newHeight =
+            HeightGenerator::template generate<MaximumHeight>();
+        m_topLevel.raise(newHeight);
+
+        std::array<Version, MaximumHeight> versions{};
+        SleepingBackoff backoff;
         while (true) {
-            const auto foundLevel = find(value, predecessors, successors);
+            const auto foundLevel = find(key, predecessors, successors,
+                                         fromPredecessors, versions.data());
             if (foundLevel != -1) { // already in list
                 const auto& foundNode = successors[foundLevel];
                 if (!foundNode->marked) {
                     while (!foundNode->fullyLinked) {
                     } // wait until found node is completely inserted
+                    visitExisting(foundNode->mapped);
 #ifdef COLLECT_STATISTICS
                     SkipListStatistics::threadLocalInstance()
                         .insertionFailure();
@@ -104,24 +427,32 @@ class LazySkipList final : public SkipList<T>
                 continue; // retry until found node is removed
             }
 
-            // insert node
-            bool valid = true;
-            std::uint16_t maxLockedLevel = 0;
+            // insert node, a node which is the predecessor on several levels
+            // is locked once
+            std::uint16_t lockedLevels = 0;
+            Version lockedVersion = 0;
+            bool valid = isUnchanged(predecessors, versions, newHeight);
             for (std::uint16_t level = 0; valid && (level <= newHeight);
                  ++level) {
                 const auto& pred = predecessors[level];
                 const auto& succ = successors[level];
-                pred->mutex.lock();
-                maxLockedLevel = level;
-                valid =
-                    !pred->marked && !succ->marked && pred->next[level] == succ;
+                if (level == 0 || pred != predecessors[level - 1]) {
+                    lockedVersion = versions[level];
+                    if (!lockNode(pred, lockedVersion)) {
+                        break;
+                    }
+                }
+                lockedLevels = level + 1;
+                valid = !pred->marked && !succ->marked &&
+                        isLinked(pred, level, succ, versions[level],
+                                 lockedVersion) &&
+                        (!SuccessorKeys::Enabled || !isBefore(succ, key));
             }
 
-            if (!valid) { // invalid state -> retry
-                // unlock predecessors
-                for (std::uint16_t level = 0; level <= maxLockedLevel;
-                     ++level) {
-                    predecessors[level]->mutex.unlock();
+            if (!valid || lockedLevels <= newHeight) { // invalid -> retry
+                unlockPredecessors(predecessors, lockedLevels);
+                if (Validation::Optimistic) {
+                    backoff(); // don't fail again until the holder is done
                 }
 #ifdef COLLECT_STATISTICS
                 SkipListStatistics::threadLocalInstance().insertionRetry();
@@ -130,17 +461,26 @@ class LazySkipList final : public SkipList<T>
             }
 
             // update successors and predecessors
-            const auto& newNode = new Node(value, newHeight);
-            newNode->next = successors;
+            const auto& newNode = createTowerNode<Node>(
+                m_allocator, Storage::store(m_keyArena, key), newHeight);
+            newNode->mapped.store(makeMapped(), std::memory_order_relaxed);
+            for (std::uint16_t level = 0; level <= newHeight; ++level) {
+                link(newNode, level, successors[level]);
+            }
             for (std::uint16_t level = 0; level <= newHeight; ++level) {
-                predecessors[level]->next[level] = newNode;
+                link(predecessors[level], level, newNode);
             }
             newNode->fullyLinked = true; // insert linearization point
             ++m_size;
 
-            // unlock predecessors
-            for (std::uint16_t level = 0; level <= maxLockedLevel; ++level) {
-                predecessors[level]->mutex.unlock();
+            unlockPredecessors(predecessors, lockedLevels);
+
+            if (fromPredecessors) {
+                // a following key behind the new node continues from it,
+                // which makes appending at the tail a constant time search
+                for (std::uint16_t level = 0; level <= newHeight; ++level) {
+                    predecessors[level] = newNode;
+                }
             }
 
 #ifdef COLLECT_STATISTICS
@@ -150,17 +490,21 @@ class LazySkipList final : public SkipList<T>
         }
     }
 
-    bool remove(const_reference value) override
+    bool remove(const key_type& key,
+                std::array<Node*, MaximumHeight>& predecessors,
+                std::array<Node*, MaximumHeight>& successors,
+                bool fromPredecessors)
     {
 #ifdef COLLECT_STATISTICS
         SkipListStatistics::threadLocalInstance().deletionStart();
 #endif
         bool retryInProgress = false;
-        std::array<Node*, MaximumHeight> predecessors;
-        std::array<Node*, MaximumHeight> successors;
+        std::array<Version, MaximumHeight> versions{};
+        SleepingBackoff backoff;
 
         while (true) {
-            const auto foundLevel = find(value, predecessors, successors);
+            const auto foundLevel = find(key, predecessors, successors,
+                                         fromPredecessors, versions.data());
             if (foundLevel == -1) { // node not found
 #ifdef COLLECT_STATISTICS
                 SkipListStatistics::threadLocalInstance().deletionFailure();
@@ -172,9 +516,9 @@ class LazySkipList final : public SkipList<T>
             if (retryInProgress || (node->fullyLinked && !node->marked &&
                                     node->height == foundLevel)) {
                 if (!retryInProgress) { // executed only on first try
-                    node->mutex.lock();
+                    lockNode(node);
                     if (node->marked) {
-                        node->mutex.unlock();
+                        node->lock.unlock();
 #ifdef COLLECT_STATISTICS
                         SkipListStatistics::threadLocalInstance()
                             .deletionFailure();
@@ -182,26 +526,34 @@ class LazySkipList final : public SkipList<T>
                         return false;
                     }
                     node->marked = true; // remove linearization point
-                    m_size--;
+                    --m_size;
                     retryInProgress = true;
                 }
 
-                // lock predecessors
-                bool valid = true;
-                std::uint16_t maxLockedLevel = 0;
+                // lock predecessors, each distinct one once
+                std::uint16_t lockedLevels = 0;
+                Version lockedVersion = 0;
+                bool valid =
+                    isUnchanged(predecessors, versions, node->height);
                 for (std::uint16_t level = 0; valid && (level <= node->height);
                      ++level) {
                     const auto& pred = predecessors[level];
-                    pred->mutex.lock();
-                    maxLockedLevel = level;
-                    valid = !pred->marked && pred->next[level] == node;
+                    if (level == 0 || pred != predecessors[level - 1]) {
+                        lockedVersion = versions[level];
+                        if (!lockNode(pred, lockedVersion)) {
+                            break;
+                        }
+                    }
+                    lockedLevels = level + 1;
+                    valid = !pred->marked && isLinked(pred, level, node,
+                                                      versions[level],
+                                                      lockedVersion);
                 }
 
-                if (!valid) { // invalid state -> retry
-                    // unlock predecessors
-                    for (std::uint16_t level = 0; level <= maxLockedLevel;
-                         ++level) {
-                        predecessors[level]->mutex.unlock();
+                if (!valid || lockedLevels <= node->height) { // -> retry
+                    unlockPredecessors(predecessors, lockedLevels);
+                    if (Validation::Optimistic) {
+                        backoff();
                     }
 #ifdef COLLECT_STATISTICS
                     SkipListStatistics::threadLocalInstance().deletionRetry();
@@ -213,17 +565,24 @@ class LazySkipList final : public SkipList<T>
                 for (std::int32_t level = node->height; level >= 0; --level) {
                     predecessors[level]->next[level] = node->next[level];
                 }
-                node->mutex.unlock();
+                node->lock.unlock();
+                unlockPredecessors(predecessors, lockedLevels);
 
-                // unlock predecessors
-                for (std::uint16_t level = 0; level <= maxLockedLevel;
-                     ++level) {
-                    predecessors[level]->mutex.unlock();
-                }
+                // node is unreachable now, free it once no concurrent
+                // operation can hold a reference to it anymore
+                m_reclamation.retire(node, &reclaimNode, this);
 #ifdef COLLECT_STATISTICS
                 SkipListStatistics::threadLocalInstance().deletionSuccess();
 #endif
                 return true;
+            } else if (node->fullyLinked && !node->marked) {
+                // the node has been found below its top level: the search
+                // started below it with an older top level hint, or a torn
+                // cached key has hidden it
+#ifdef COLLECT_STATISTICS
+                SkipListStatistics::threadLocalInstance().deletionRetry();
+#endif
+                continue;
             } else { // node virtually not in list
 #ifdef COLLECT_STATISTICS
                 SkipListStatistics::threadLocalInstance().deletionFailure();
@@ -233,59 +592,141 @@ class LazySkipList final : public SkipList<T>
         }
     }
 
-    bool contains(const_reference value) override
+    template <typename Visit>
+    bool visit(const key_type& key, Visit visit,
+               std::array<Node*, MaximumHeight>& predecessors,
+               std::array<Node*, MaximumHeight>& successors,
+               bool fromPredecessors)
     {
 #ifdef COLLECT_STATISTICS
         SkipListStatistics::threadLocalInstance().lookupStart();
 #endif
-        std::array<Node*, MaximumHeight> predecessors;
-        std::array<Node*, MaximumHeight> successors;
-        const auto onLevel = find(value, predecessors, successors);
+        const auto onLevel =
+            find(key, predecessors, successors, fromPredecessors);
 
 #ifdef COLLECT_STATISTICS
         SkipListStatistics::threadLocalInstance().lookupDone();
 #endif
-        return onLevel != -1 && successors[onLevel]->fullyLinked &&
-               !successors[onLevel]->marked;
+        if (onLevel == -1 || !successors[onLevel]->fullyLinked ||
+            successors[onLevel]->marked) {
+            return false;
+        }
+        visit(successors[onLevel]->mapped);
+        return true;
     }
 
-    void clear() override
+    /**
+     * Read-only search of `visitMany`, see interleavedSearch.
+     */
+    template <typename Visit>
+    class InterleavedVisit
     {
-        // TODO not linearizable?
-        std::lock_guard<std::recursive_mutex> lock(m_head->mutex);
+      public:
+        using key_type = Key;
+        using Node = typename LazySkipListEngine::Node;
 
-        // mark all nodes (expect of head and sentinel)
-        for (auto& current = m_head->next[0]; current != m_sentinel;
-             current = current->next[0]) {
-            while (not current->fullyLinked or current->marked) {
-            }
-            std::lock_guard<std::recursive_mutex> currentLock(current->mutex);
-            current->marked = true; // ignore if it was marked in the meantime
+        InterleavedVisit(const LazySkipListEngine& engine, Visit& visit)
+            : m_engine(engine)
+            , m_visit(visit)
+        {
         }
 
-        // fully re-connect head with sentinel
-        for (std::uint16_t level = 0; level < MaximumHeight; ++level) {
-            m_head->next[level] = m_sentinel;
+        Node* head() const
+        {
+            return m_engine.m_head;
         }
 
-        m_size = 0;
-    }
+        std::int32_t topLevel() const
+        {
+            return m_engine.m_topLevel.load();
+        }
 
-  private:
-    std::int32_t find(const_reference value,
+        Node* next(const Node* node, std::int32_t level) const
+        {
+            return node->next[level];
+        }
+
+        bool isRemoved(const Node*, std::int32_t) const
+        {
+            return false; // removed nodes keep their links, like in `find`
+        }
+
+        bool isBefore(const Node* node, const key_type& key) const
+        {
+            return m_engine.isBefore(node, key);
+        }
+
+        bool found(Node* node, const key_type& key)
+        {
+            if (!m_engine.holds(node, key) || !node->fullyLinked ||
+                node->marked) {
+                return false;
+            }
+            m_visit(node->mapped);
+            return true;
+        }
+
+      private:
+        const LazySkipListEngine& m_engine;
+        Visit& m_visit;
+    };
+
+    /**
+     * Searches the levels from the top level hint down, `predecessors` and
+     * `successors` are left untouched above it.
+     * @tparam SkipEqual Stop at the first node greater than `key` instead of
+     * the first node not less than `key`
+     * @param fromPredecessors Start each level at the node in `predecessors`
+     * (the search path of a preceding key) if it precedes `key`, is closer to
+     * it than the predecessor reached from the level above and not removed,
+     * instead of descending from the head only
+     * @param versions Receives the lock versions of `predecessors`, read
+     * before their successors, if not null and the validation is optimistic
+     * @return Highest level on which the node holding `key` has been found,
+     * -1 if it is not present
+     */
+    template <bool SkipEqual = false>
+    std::int32_t find(const key_type& key,
                       std::array<Node*, MaximumHeight>& predecessors,
-                      std::array<Node*, MaximumHeight>& successors) const
+                      std::array<Node*, MaximumHeight>& successors,
+                      bool fromPredecessors = false,
+                      Version* versions = nullptr) const
     {
+        const bool recordVersions = Validation::Optimistic && versions;
         std::int32_t foundLevel = -1;
         auto* pred = m_head;
-        for (std::int32_t level = (MaximumHeight - 1); level >= 0; --level) {
-            auto* curr = pred->next[level];
-            while (curr->value < value) {
-                pred = curr;
-                curr = pred->next[level];
+        for (std::int32_t level = m_topLevel.load(); level >= 0; --level) {
+            if (fromPredecessors) {
+                pred = closerPredecessor(pred, predecessors[level], key);
+            }
+            if (recordVersions) {
+                versions[level] = Validation::version(pred->lock);
+            }
+            auto next = pred->next[level];
+            prefetchCandidates(pred, next, level);
+            while (SkipEqual ? isNotAfter(next, key) : precedes(next, key)) {
+                pred = next;
+                if (recordVersions) {
+                    versions[level] = Validation::version(pred->lock);
+                }
+                next = pred->next[level];
+                prefetchCandidates(pred, next, level);
+            }
+            Node* curr = next;
+            if (SuccessorKeys::Enabled && level == 0) {
+                // the result must not rely on a torn cached key
+                while (SkipEqual ? isNotAfter(curr, key)
+                                 : isBefore(curr, key)) {
+                    pred = curr;
+                    if (recordVersions) {
+                        versions[level] = Validation::version(pred->lock);
+                    }
+                    curr = pred->next[level];
+                }
             }
 
-            if (foundLevel == -1 && curr->value == value) {
+            if (foundLevel == -1 &&
+                (level == 0 ? holds(curr, key) : holds(next, key))) {
                 foundLevel = level;
             }
             predecessors[level] = pred;
@@ -295,29 +736,280 @@ class LazySkipList final : public SkipList<T>
     }
 
     /**
-     * @return Random height in range [0..MaximumHeight[
+     * Prefetches the nodes the search compares after `next`, the successor
+     * of `pred` on `level`: the successor of `next` if it moves to `next`,
+     * the successor of `pred` on the level below otherwise.
      */
-    static std::uint16_t randomHeight()
-    {
-        std::random_device randomDevice;
-        static thread_local std::mt19937 generator(randomDevice());
-        std::bernoulli_distribution distribution(0.5);
-        const auto flipCoinAndCheckIfHead = [&] {
-            return distribution(generator) == true;
-        };
-
-        std::uint16_t height = 0;
-        while (not flipCoinAndCheckIfHead() and
-               (height < (MaximumHeight - 1))) {
-            ++height;
+    void prefetchCandidates(const Node* pred, const Node* next,
+                            std::int32_t level) const
+    {
+        if (!Prefetching::Enabled) {
+            return;
         }
+        if (next != m_sentinel) {
+            Prefetching::node(static_cast<Node*>(next->next[level]), level);
+        }
+        if (level > 0) {
+            Prefetching::node(static_cast<Node*>(pred->next[level - 1]),
+                              level - 1);
+        }
+    }
 
-        assert(height < MaximumHeight);
-        return height;
+    void lockNode(Node* node)
+    {
+        node->lock.lock();
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lockAcquired();
+#endif
+    }
+
+    /**
+     * Locks the predecessor `node`, fails if the validation is optimistic
+     * and `node` no longer has the lock version `version`.
+     */
+    bool lockNode(Node* node, Version version)
+    {
+        if (!Validation::lock(node->lock, version)) {
+            return false;
+        }
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lockAcquired();
+#endif
+        return true;
+    }
+
+    /**
+     * @return false if the validation is optimistic and one of the
+     * predecessors on the levels [0, height] has been locked or changed
+     * since the search, checked without taking any lock
+     */
+    static bool
+    isUnchanged(const std::array<Node*, MaximumHeight>& predecessors,
+                const std::array<Version, MaximumHeight>& versions,
+                std::uint16_t height)
+    {
+        for (std::uint16_t level = 0; level <= height; ++level) {
+            if (!Validation::isVersion(predecessors[level]->lock,
+                                       versions[level])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @return true if the locked `pred` still precedes `succ` on `level`.
+     * With optimistic validation this holds without reading the link if
+     * `pred` has been locked at the version read before `succ`.
+     */
+    static bool isLinked(const Node* pred, std::uint16_t level,
+                         const Node* succ, Version observedVersion,
+                         Version lockedVersion)
+    {
+        return (Validation::Optimistic && observedVersion == lockedVersion) ||
+               pred->next[level] == succ;
+    }
+
+    /**
+     * Unlocks the predecessors on the levels [0, lockedLevels). The
+     * predecessors are ordered, so a node which is the predecessor on
+     * several levels is on consecutive ones and has been locked once.
+     */
+    static void
+    unlockPredecessors(const std::array<Node*, MaximumHeight>& predecessors,
+                       std::uint16_t lockedLevels)
+    {
+        for (std::uint16_t level = 0; level < lockedLevels; ++level) {
+            if (level == 0 || predecessors[level] != predecessors[level - 1]) {
+                predecessors[level]->lock.unlock();
+            }
+        }
+    }
+
+    /**
+     * @return The one of both predecessors of `key` on the same level which
+     * is closer to it, `previous` only if it precedes `key` and has not been
+     * removed
+     */
+    Node* closerPredecessor(Node* pred, Node* previous,
+                            const key_type& key) const
+    {
+        if (previous == m_head || previous->marked ||
+            !isBefore(previous, key)) {
+            return pred;
+        }
+        if (pred == m_head || m_compare(pred->key, previous->key)) {
+            return previous;
+        }
+        return pred;
+    }
+
+    template <bool SkipEqual>
+    const_iterator bound(const key_type& key)
+    {
+        auto guard = createGuard();
+        std::array<Node*, MaximumHeight> predecessors;
+        std::array<Node*, MaximumHeight> successors;
+        find<SkipEqual>(key, predecessors, successors);
+        return const_iterator(this, skipRemoved(successors[0]),
+                              std::move(guard));
+    }
+
+    std::unique_ptr<Guard> createGuard()
+    {
+        return std::unique_ptr<Guard>(new Guard(m_reclamation));
+    }
+
+    /**
+     * @return `node` or the first node behind it which is fully linked and
+     * not removed
+     */
+    Node* skipRemoved(Node* node) const
+    {
+        while (node != m_sentinel && (!node->fullyLinked || node->marked)) {
+            node = node->next[0];
+        }
+        return node;
+    }
+
+    Node* nextNode(Node* node) const
+    {
+        return skipRemoved(node->next[0]);
+    }
+
+    static void reclaimNode(void* engine, void* pointer)
+    {
+        auto* node = static_cast<Node*>(pointer);
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().nodeReclaimed(
+            towerNodeSize<Node>(node->height));
+#endif
+        static_cast<LazySkipListEngine*>(engine)->destroyNode(node);
+    }
+
+    void destroyNode(Node* node)
+    {
+        Storage::release(m_keyArena, node->key);
+        destroyTowerNode(m_allocator, node);
+    }
+
+    /**
+     * @return true if `node` precedes `key`, the sentinel succeeds all keys
+     */
+    bool isBefore(const Node* node, const key_type& key) const
+    {
+        return node != m_sentinel && m_compare(node->key, key);
+    }
+
+    /**
+     * @return true if `node` precedes or holds `key`
+     */
+    bool isNotAfter(const Node* node, const key_type& key) const
+    {
+        return node != m_sentinel && !m_compare(key, node->key);
+    }
+
+    /**
+     * @return true if `node`, which must not precede `key`, holds `key`
+     */
+    bool holds(const Node* node, const key_type& key) const
+    {
+        return isNotAfter(node, key);
+    }
+
+    /**
+     * @return true if the node behind `link` (a loaded link) precedes `key`.
+     * A cached key is only trusted to stay, a move to the right is confirmed
+     * by the node, which the search loads next anyway.
+     */
+    bool precedes(const Node* link, const key_type& key) const
+    {
+        return isBefore(link, key);
+    }
+
+    bool precedes(const SuccessorKeyLink<Node, Key>& link,
+                  const key_type& key) const
+    {
+        return link.node() != m_sentinel && m_compare(link.key(), key) &&
+               m_compare(link.node()->key, key);
+    }
+
+    bool isNotAfter(const SuccessorKeyLink<Node, Key>& link,
+                    const key_type& key) const
+    {
+        return link.node() != m_sentinel && !m_compare(key, link.key()) &&
+               isNotAfter(link.node(), key);
+    }
+
+    /**
+     * @return true if the node behind `link`, which must not precede `key`,
+     * holds `key`. The node is only loaded if the cached key matches.
+     */
+    bool holds(const SuccessorKeyLink<Node, Key>& link,
+               const key_type& key) const
+    {
+        return link.node() != m_sentinel && !m_compare(key, link.key()) &&
+               holds(link.node(), key);
+    }
+
+    static void link(Node* node, std::uint16_t level, Node* succ)
+    {
+        storeLink(node->next[level], succ);
+    }
+
+    static void storeLink(Node*& link, Node* succ)
+    {
+        link = succ;
+    }
+
+    static void storeLink(SuccessorKeyLink<Node, Key>& link, Node* succ)
+    {
+        // the successor of the sentinel is nullptr
+        link.set(succ, succ != nullptr ? succ->key : key_type());
+    }
+
+    /**
+     * Destroys all nodes between head and sentinel, requires that no other
+     * thread accesses the list anymore.
+     */
+    void destroyNodes(std::true_type)
+    {
+        m_allocator.releaseAll();
+        Storage::releaseAll(m_keyArena);
+    }
+
+    void destroyNodes(std::false_type)
+    {
+        for (Node* current = m_head->next[0]; current != m_sentinel;) {
+            Node* next = current->next[0];
+            destroyNode(current);
+            current = next;
+        }
     }
 
   private:
     Node* m_head;
     Node* m_sentinel;
-    std::atomic_size_t m_size;
+    TopLevelHint m_topLevel;
+    ShardedCounter m_size;
+    Compare m_compare;
+    typename Storage::Arena m_keyArena;
+    Allocator m_allocator;
+    EpochBasedReclamation m_reclamation; // frees into m_keyArena, m_allocator
+    typename Finger::template Domain<Node, MaximumHeight> m_finger;
 };
+
+/**
+ * Lazy skip list set, see LazySkipListEngine for the parameters.
+ */
+template <typename T, std::uint16_t MaximumHeight,
+          typename Allocator = HeapNodeAllocator,
+          typename HeightGenerator = HalfHeightGenerator,
+          typename Compare = std::less<T>, typename Finger = NoFinger,
+          typename Validation = LockThenValidate,
+          typename SuccessorKeys = NoSuccessorKeys,
+          typename Prefetching = NoPrefetching>
+using LazySkipList = EngineSkipList<
+    LazySkipListEngine<T, NoMapped, MaximumHeight, Allocator, HeightGenerator,
+                       Compare, Finger, Validation, SuccessorKeys,
+                       Prefetching>>;
@@ -1,95 +1,596 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cassert>
+#include <functional>
 #include <limits>
+#include <memory>
 #include <mutex>
-#include <random>
+#include <type_traits>
+#include <vector>
 
 #include "AtomicMarkableReference.h"
-#include "SkipList.h"
+#include "BulkLoad.h"
+#include "EpochBasedReclamation.h"
+#include "FingerSearch.h"
+#include "HazardPointerReclamation.h"
+#include "HeightGenerator.h"
+#include "InterleavedSearch.h"
+#include "KeyStorage.h"
+#include "NoReclamation.h"
+#include "NodeAllocator.h"
+#include "NodeTower.h"
+#include "Prefetching.h"
+#include "ShardedCounter.h"
+#include "SkipListEngine.h"
+#include "SnapshotDomain.h"
 #include "SkipListStatistics.h"
+#include "TopLevelHint.h"
 
-template <typename T, std::uint16_t MaximumHeight>
-class LockFreeSkipList final : public SkipList<T>
+/**
+ * Number of hazard slots per thread of a reclamation policy, unlimited for
+ * the policies without hazard pointers.
+ */
+template <typename Reclamation,
+          bool HasHazards = Reclamation::RequiresValidation>
+struct HazardCapacity {
+    static constexpr std::size_t value =
+        std::numeric_limits<std::size_t>::max();
+};
+
+template <typename Reclamation>
+struct HazardCapacity<Reclamation, true> {
+    static constexpr std::size_t value = Reclamation::MaximumHazardsPerThread;
+};
+
+/**
+ * Lock-free skip list (Herlihy & Shavit, 2008) which maps each key to a value,
+ * see SkipListEngine.h for the interface.
+ *
+ * @tparam Mapped Trivially copyable value, replaced and updated atomically
+ * @tparam MaximumHeight Number of levels of the head. The searches start at
+ * the highest level in use (see TopLevelHint), so a maximum which suits the
+ * largest lists doesn't slow down small ones.
+ * @tparam Reclamation Policy which frees removed nodes, one of
+ * EpochBasedReclamation, HazardPointerReclamation or NoReclamation
+ * @tparam Allocator Provides the memory of the nodes, HeapNodeAllocator or
+ * SlabNodeAllocator
+ * @tparam HeightGenerator Policy which draws the height of new nodes, e.g.
+ * HalfHeightGenerator, QuarterHeightGenerator or InverseEHeightGenerator
+ * @tparam Compare Strict weak ordering of the keys, head and sentinel are
+ * compared by address and don't need a smallest or largest key
+ * @tparam Snapshots NoSnapshots or VersionedSnapshots, which labels updates
+ * with versions to support linearizable `snapshotScan`s
+ * @tparam Finger NoFinger or ThreadFinger, which starts every search from
+ * the search path of the previous operation of the thread
+ * @tparam Prefetching NoPrefetching or SuccessorPrefetching, which prefetches
+ * both nodes a search step may continue with
+ */
+template <typename Key, typename Mapped, std::uint16_t MaximumHeight,
+          typename Reclamation = EpochBasedReclamation,
+          typename Allocator = HeapNodeAllocator,
+          typename HeightGenerator = HalfHeightGenerator,
+          typename Compare = std::less<Key>,
+          typename Snapshots = NoSnapshots, typename Finger = NoFinger,
+          typename Prefetching = NoPrefetching>
+class LockFreeSkipListEngine
 {
   public:
     static_assert(MaximumHeight > 0, "Maximum height must be greater than 0");
+    static_assert(!Snapshots::Enabled || !Reclamation::RequiresValidation,
+                  "Snapshots are not supported with hazard pointers");
+    static_assert(!Finger::Enabled || !Reclamation::RequiresValidation,
+                  "Finger search is not supported with hazard pointers");
+    static_assert(std::is_trivially_copyable<Mapped>::value,
+                  "Mapped must be trivially copyable");
 
-    using value_type = typename SkipList<T>::value_type;
-    using reference = typename SkipList<T>::reference;
-    using const_reference = typename SkipList<T>::const_reference;
-    using pointer = typename SkipList<T>::pointer;
-    using const_pointer = typename SkipList<T>::const_pointer;
-    using difference_type = typename SkipList<T>::difference_type;
-    using size_type = typename SkipList<T>::size_type;
+    using key_type = Key;
+    using mapped_type = Mapped;
+    using size_type = std::size_t;
 
   private:
     struct Node {
-        Node(const_reference value, std::uint16_t height)
-            : value(value)
+        Node(const key_type& key, std::uint16_t height)
+            : key(key)
             , height(height)
+            , references(2 + Snapshots::References)
+            , mapped()
+            , next(height)
         {
         }
 
-        const value_type value;
+        const key_type key;
         const std::uint16_t height;
-        std::array<AtomicMarkableReference<Node>, MaximumHeight> next;
+
+        // the inserting and the removing thread both release the node when
+        // they are done with it, as well as the removal log of the snapshots,
+        // the last one retires it (see `release`)
+        std::atomic<std::uint8_t> references;
+
+        std::atomic<mapped_type> mapped;
+        typename Snapshots::template Labels<Node> labels;
+        NodeTower<AtomicMarkableReference<Node>> next; // must be the last
     };
 
+    using Storage = KeyStorage<key_type>;
+
+    // the allocator can drop all nodes at once, no need to visit them
+    static constexpr bool ReleasesAllNodesAtOnce =
+        Allocator::ReleasesAllOnDestruction &&
+        std::is_trivially_destructible<Node>::value;
+
+    using Guard = typename Reclamation::Guard;
+
+    // hazard slots used by `find`, followed by one slot per predecessor and
+    // one per successor and two slots for `rangeScan`
+    static const std::size_t PredecessorSlot = 0;
+    static const std::size_t CurrentSlot = 1;
+    static const std::size_t NumberOfHazardSlots = 2 + 2 * MaximumHeight + 2;
+
+    static_assert(NumberOfHazardSlots <= HazardCapacity<Reclamation>::value,
+                  "The hazard pointers have too few slots for MaximumHeight");
+
   public:
-    LockFreeSkipList()
-        : m_head(new Node(std::numeric_limits<value_type>::min(),
-                          MaximumHeight - 1))
-        , m_sentinel(new Node(std::numeric_limits<value_type>::max(),
-                              MaximumHeight - 1))
-        , m_size(0)
+    using const_iterator = EngineIterator<LockFreeSkipListEngine, Node>;
+
+  public:
+    LockFreeSkipListEngine()
+        : m_head(createTowerNode<Node>(key_type(), MaximumHeight - 1))
+        , m_sentinel(createTowerNode<Node>(key_type(), MaximumHeight - 1))
+        , m_topLevel()
+        , m_size()
+        , m_compare()
+        , m_keyArena()
+        , m_allocator()
+        , m_snapshots()
+        , m_reclamation()
+        , m_finger()
     {
         for (std::uint16_t level = 0; level <= MaximumHeight - 1; ++level) {
             m_head->next[level].set(m_sentinel, false);
         }
     }
 
-    ~LockFreeSkipList() override
+    ~LockFreeSkipListEngine()
     {
-        for (auto* current = m_head; current != nullptr;) {
-            auto* next = current->next[0].getReference();
-            delete current;
-            current = next;
+        // pending nodes must be freed before the allocator drops them
+        m_reclamation.reclaimAll();
+        m_snapshots.drain([this](Node* node) { destroyNode(node); });
+        destroyNodes(std::integral_constant<bool, ReleasesAllNodesAtOnce>());
+
+        // head and sentinel are not part of the allocator
+        destroyTowerNode(m_head);
+        destroyTowerNode(m_sentinel);
+    }
+
+    bool empty()
+    {
+        return m_size.value() == 0;
+    }
+
+    size_type size()
+    {
+        return m_size.value();
+    }
+
+    size_type sizeEstimate()
+    {
+        return m_size.estimate();
+    }
+
+    /**
+     * @return Highest level on which a node may be linked, where the searches
+     * start (see TopLevelHint)
+     */
+    std::uint16_t topLevel() const
+    {
+        return m_topLevel.load();
+    }
+
+    template <typename MakeMapped, typename VisitExisting>
+    bool insert(const key_type& key, MakeMapped makeMapped,
+                VisitExisting visitExisting)
+    {
+        Guard guard(m_reclamation);
+        std::array<Node*, MaximumHeight> path;
+        auto& predecessors = m_finger.path(path, m_head, guard);
+        std::array<Node*, MaximumHeight> successors;
+        return insert(key, makeMapped, visitExisting, predecessors,
+                      successors, guard, Finger::Enabled);
+    }
+
+    bool remove(const key_type& key)
+    {
+        Guard guard(m_reclamation);
+        std::array<Node*, MaximumHeight> path;
+        auto& predecessors = m_finger.path(path, m_head, guard);
+        std::array<Node*, MaximumHeight> successors;
+        return remove(key, predecessors, successors, guard, Finger::Enabled);
+    }
+
+    template <typename Visit>
+    bool visit(const key_type& key, Visit visit)
+    {
+        Guard guard(m_reclamation);
+
+        if (Reclamation::RequiresValidation || Snapshots::Enabled ||
+            Finger::Enabled) {
+            // marked nodes may be freed while they are traversed, only a
+            // validating search is safe; it also labels the traversed nodes
+            // and maintains the finger
+            std::array<Node*, MaximumHeight> path;
+            auto& predecessors = m_finger.path(path, m_head, guard);
+            std::array<Node*, MaximumHeight> successors;
+            return this->visit(key, visit, predecessors, successors, guard,
+                               Finger::Enabled);
+        }
+
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupStart();
+#endif
+        Node* pred = m_head;
+        Node* curr = nullptr;
+        Node* succ = nullptr;
+        bool marked = false;
+
+        for (std::int32_t level = m_topLevel.load(); level >= 0; --level) {
+            curr = pred->next[level].get(marked);
+            while (true) {
+                succ = curr->next[level].get(marked);
+                // ignore marked nodes
+                while (marked) {
+                    curr = curr->next[level].getReference();
+                    succ = curr->next[level].get(marked);
+                }
+
+                if (isBefore(curr, key)) {
+                    pred = curr;
+                    curr = succ;
+                } else {
+                    break;
+                }
+            }
+        }
+
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupDone();
+#endif
+
+        if (!holds(curr, key)) {
+            return false;
+        }
+        visit(curr->mapped);
+        return true;
+    }
+
+    /**
+     * Batched `insert` of the sorted range [first, last), see
+     * SkipList::insertBatch.
+     */
+    template <typename MakeMapped, typename VisitExisting>
+    size_type insertBatch(const key_type* first, const key_type* last,
+                          MakeMapped makeMapped, VisitExisting visitExisting,
+                          bool* results)
+    {
+        Guard guard(m_reclamation);
+
+        std::array<Node*, MaximumHeight> predecessors;
+        std::array<Node*, MaximumHeight> successors;
+        predecessors.fill(m_head);
+        size_type count = 0;
+        for (; first != last; ++first, ++results) {
+            *results = insert(*first, makeMapped, visitExisting, predecessors,
+                              successors, guard, true);
+            count += *results ? 1 : 0;
+        }
+        return count;
+    }
+
+    size_type removeBatch(const key_type* first, const key_type* last,
+                          bool* results)
+    {
+        Guard guard(m_reclamation);
+
+        std::array<Node*, MaximumHeight> predecessors;
+        std::array<Node*, MaximumHeight> successors;
+        predecessors.fill(m_head);
+        size_type count = 0;
+        for (; first != last; ++first, ++results) {
+            *results = remove(*first, predecessors, successors, guard, true);
+            count += *results ? 1 : 0;
         }
+        return count;
     }
 
-    bool empty() override
+    /**
+     * Batched `visit`, which always takes the validating search.
+     */
+    template <typename Visit>
+    size_type visitBatch(const key_type* first, const key_type* last,
+                         Visit visit, bool* results)
     {
-        return m_size == 0;
+        Guard guard(m_reclamation);
+
+        std::array<Node*, MaximumHeight> predecessors;
+        std::array<Node*, MaximumHeight> successors;
+        predecessors.fill(m_head);
+        size_type count = 0;
+        for (; first != last; ++first, ++results) {
+            *results = this->visit(*first, visit, predecessors, successors,
+                                   guard, true);
+            count += *results ? 1 : 0;
+        }
+        return count;
     }
 
-    size_type size() override
+    /**
+     * `visit` of the unordered keys [first, last), whose searches are
+     * interleaved to overlap their cache misses (see SkipList::containsMany)
+     * if `visit` takes the wait-free search, one after another otherwise.
+     */
+    template <typename Visit>
+    size_type visitMany(const key_type* first, const key_type* last,
+                        Visit visit, bool* results)
     {
-        return m_size;
+        if (Reclamation::RequiresValidation || Snapshots::Enabled ||
+            Finger::Enabled) {
+            size_type count = 0;
+            for (; first != last; ++first, ++results) {
+                *results = this->visit(*first, visit);
+                count += *results ? 1 : 0;
+            }
+            return count;
+        }
+
+        Guard guard(m_reclamation);
+        InterleavedVisit<Visit> search(*this, visit);
+        return interleavedSearch(search, first, last, results);
     }
 
-    bool insert(const_reference value) override
+    /**
+     * Inserts the sorted range [first, last) with the keys `getKey(*it)` and
+     * the values `getMapped(*it)`, see SkipList::bulkLoad. Must not run
+     * concurrently with other operations.
+     * @return Number of inserted keys
+     */
+    template <typename Iterator, typename GetKey, typename GetMapped>
+    size_type bulkLoad(Iterator first, Iterator last, GetKey getKey,
+                       GetMapped getMapped)
+    {
+        if (m_head->next[0].getReference() != m_sentinel) {
+            size_type count = 0;
+            for (; first != last; ++first) {
+                const mapped_type mapped = getMapped(*first);
+                if (insert(getKey(*first), ConstantMapped<mapped_type>(mapped),
+                           IgnoreMapped())) {
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        const auto result =
+            BulkLoader<Node, MaximumHeight, HeightGenerator>::load(
+                m_head, m_sentinel, first, last, getKey, m_compare,
+                [&](Iterator current, std::uint16_t height) {
+                    auto* node = createTowerNode<Node>(
+                        m_allocator,
+                        Storage::store(m_keyArena, getKey(*current)), height);
+                    node->mapped.store(getMapped(*current),
+                                       std::memory_order_relaxed);
+                    // there is no inserting thread which releases the node
+                    node->references.store(1 + Snapshots::References,
+                                           std::memory_order_relaxed);
+                    m_snapshots.labelInsert(node);
+                    return node;
+                },
+                [](Node* pred, std::uint16_t level, Node* succ) {
+                    pred->next[level].set(succ, false);
+                });
+        m_topLevel.raise(result.height);
+        m_size.add(result.count);
+        return result.count;
+    }
+
+    template <typename Visit>
+    size_type rangeScan(const key_type& lo, const key_type& hi, Visit visit)
     {
 #ifdef COLLECT_STATISTICS
-        SkipListStatistics::threadLocalInstance().insertionStart();
+        SkipListStatistics::threadLocalInstance().lookupStart();
+#endif
+        Guard guard(m_reclamation);
+
+        std::array<Node*, MaximumHeight> predecessors;
+        std::array<Node*, MaximumHeight> successors;
+        find(lo, predecessors, successors, guard);
+
+        // the current node stays protected by one of the two scan slots
+        // while its successor is published in the other one
+        std::size_t slot = 0;
+        Node* node = successors[0];
+        guard.protect(scanSlot(slot), node);
+
+        size_type count = 0;
+        while (isBefore(node, hi)) {
+            bool marked = false;
+            Node* next = node->next[0].get(marked);
+            if (!marked) {
+                visit(node->key, node->mapped);
+                ++count;
+            }
+
+            slot ^= 1;
+            if (!protect(guard, scanSlot(slot), node->next[0], next)) {
+                // a removed node might link to reclaimed nodes, continue
+                // behind it from the top of the list
+                find<true>(node->key, predecessors, successors, guard);
+                next = successors[0];
+                guard.protect(scanSlot(slot), next);
+            }
+            node = next;
+        }
+
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupDone();
+#endif
+        return count;
+    }
+
+    /**
+     * Like `rangeScan`, but visits exactly the keys in [lo, hi) which have
+     * been in the list at a single point in time between the call and its
+     * return. Only the set of keys is versioned, the mapped values are read
+     * while they are visited. Requires VersionedSnapshots.
+     */
+    template <typename Visit>
+    size_type snapshotScan(const key_type& lo, const key_type& hi,
+                           Visit visit)
+    {
+        static_assert(Snapshots::Enabled,
+                      "Snapshot scans require VersionedSnapshots");
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupStart();
 #endif
-        std::uint16_t topLevel = randomHeight();
+        Guard guard(m_reclamation);
+        const auto version = m_snapshots.beginSnapshot();
+
+        // collect the visible nodes of the list, including marked ones, and
+        // the visible nodes which have been unlinked in the meantime
+        std::vector<Node*> nodes;
         std::array<Node*, MaximumHeight> predecessors;
         std::array<Node*, MaximumHeight> successors;
+        find(lo, predecessors, successors, guard);
+        for (auto* node = successors[0]; isBefore(node, hi);) {
+            bool marked = false;
+            auto* next = node->next[0].get(marked);
+            if (m_snapshots.isVisible(node, marked, version)) {
+                nodes.push_back(node);
+            }
+            node = next;
+        }
+        m_snapshots.forEachLoggedNode([&](Node* node) {
+            if (!m_compare(node->key, lo) && m_compare(node->key, hi) &&
+                m_snapshots.isVisible(node, true, version)) {
+                nodes.push_back(node);
+            }
+        });
+        m_snapshots.endSnapshot();
+
+        // at most one node per key is visible, but a node might have been
+        // collected from the list and from a log
+        std::sort(nodes.begin(), nodes.end(), [this](Node* lhs, Node* rhs) {
+            return m_compare(lhs->key, rhs->key);
+        });
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+        for (auto* node : nodes) {
+            visit(node->key, node->mapped);
+        }
+
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupDone();
+#endif
+        return nodes.size();
+    }
+
+    const_iterator begin()
+    {
+        static_assert(!Reclamation::RequiresValidation,
+                      "Iterators are not supported with hazard pointers");
+        auto guard = createGuard();
+        auto* first = m_head->next[0].getReference();
+        return const_iterator(this, skipRemoved(first), std::move(guard));
+    }
+
+    const_iterator end()
+    {
+        return const_iterator(this, m_sentinel, nullptr);
+    }
+
+    const_iterator lower_bound(const key_type& key)
+    {
+        return bound<false>(key);
+    }
+
+    const_iterator upper_bound(const key_type& key)
+    {
+        return bound<true>(key);
+    }
+
+    void clear()
+    {
+        Guard guard(m_reclamation);
+
+        std::array<Node*, MaximumHeight> predecessors;
+        std::array<Node*, MaximumHeight> successors;
+
+        // remove the first node until only head and sentinel are left, the
+        // thread which marks the bottom level of a node acts as its remover
+        while (true) {
+            Node* first = m_head->next[0].getReference();
+            if (!protect(guard, CurrentSlot, m_head->next[0], first)) {
+                continue;
+            }
+            if (first == m_sentinel) {
+                break;
+            }
+
+            // `find` reuses the hazard slot of `first`, which another
+            // remover may free meanwhile unless we marked it
+            const key_type key = first->key;
+            const bool removed = markAllLevels(first);
+            find(key, predecessors, successors, guard);
+            if (removed) {
+                --m_size;
+                release(first);
+            }
+        }
+    }
+
+  private:
+    friend const_iterator;
+
+    /**
+     * @param fromPredecessors Continue the search from `predecessors`, which
+     * hold the search path of a preceding key (see `find`)
+     */
+    template <typename MakeMapped, typename VisitExisting>
+    bool insert(const key_type& key, MakeMapped makeMapped,
+                VisitExisting visitExisting,
+                std::array<Node*, MaximumHeight>& predecessors,
+                std::array<Node*, MaximumHeight>& successors, Guard& guard,
+                bool fromPredecessors)
+    {
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().insertionStart();
+#endif
+        const std::uint16_t topLevel =
+            HeightGenerator::template generate<MaximumHeight>();
+        m_topLevel.raise(topLevel);
+        Node* newNode = nullptr;
 
         while (true) {
-            // check if value already in list
-            if (find(value, predecessors, successors)) {
+            // check if key already in list
+            if (find(key, predecessors, successors, guard,
+                     fromPredecessors)) {
+                if (newNode != nullptr) { // never published
+                    destroyNode(newNode);
+                }
+                m_snapshots.labelInsert(successors[0]);
+                visitExisting(successors[0]->mapped);
 #ifdef COLLECT_STATISTICS
                 SkipListStatistics::threadLocalInstance().insertionFailure();
 #endif
                 return false;
             }
 
-            // prepare new node
-            Node* newNode = new Node(value, topLevel);
+            // prepare new node, it is reused if linking it fails
+            if (newNode == nullptr) {
+                newNode = createTowerNode<Node>(
+                    m_allocator, Storage::store(m_keyArena, key), topLevel);
+                newNode->mapped.store(makeMapped(), std::memory_order_relaxed);
+            }
             for (std::uint16_t level = 0; level <= topLevel; ++level) {
                 Node* succ = successors[level];
                 newNode->next[level].set(succ, false);
@@ -102,23 +603,46 @@ class LockFreeSkipList final : public SkipList<T>
 #ifdef COLLECT_STATISTICS
                 SkipListStatistics::threadLocalInstance().insertionRetry();
 #endif
-                delete newNode;
                 continue;
             }
-            m_size++;
+            m_snapshots.labelInsert(newNode);
+            ++m_size;
 
-            // set remaining predecessors
-            for (std::uint16_t level = 1; level <= topLevel; ++level) {
+            // set remaining predecessors, stop as soon as the new node gets
+            // removed concurrently
+            bool removed = false;
+            for (std::uint16_t level = 1; !removed && level <= topLevel;
+                 ++level) {
                 while (true) {
                     pred = predecessors[level];
                     succ = successors[level];
+                    if (!updateSuccessor(newNode, level, succ)) {
+                        removed = true;
+                        break;
+                    }
                     if (pred->next[level].compareAndSet(succ, newNode, false,
                                                         false)) {
                         break;
                     }
-                    find(value, predecessors, successors);
+                    find(key, predecessors, successors, guard);
+                }
+            }
+
+            // a concurrent remove might have missed the levels linked above
+            if (newNode->next[0].marked()) {
+                find(key, predecessors, successors, guard);
+            }
+            if (fromPredecessors) {
+                // a following key behind the new node continues from it,
+                // which makes appending at the tail a constant time search;
+                // our reference keeps it from being retired until it is
+                // protected
+                for (std::uint16_t level = 0; level <= topLevel; ++level) {
+                    guard.protect(predecessorSlot(level), newNode);
+                    predecessors[level] = newNode;
                 }
             }
+            release(newNode);
 #ifdef COLLECT_STATISTICS
             SkipListStatistics::threadLocalInstance().insertionSuccess();
 #endif
@@ -126,19 +650,21 @@ class LockFreeSkipList final : public SkipList<T>
         }
     }
 
-    bool remove(const_reference value) override
+    bool remove(const key_type& key,
+                std::array<Node*, MaximumHeight>& predecessors,
+                std::array<Node*, MaximumHeight>& successors, Guard& guard,
+                bool fromPredecessors)
     {
 #ifdef COLLECT_STATISTICS
         SkipListStatistics::threadLocalInstance().deletionStart();
 #endif
-        std::array<Node*, MaximumHeight> predecessors;
-        std::array<Node*, MaximumHeight> successors;
         bool marked = false;
         Node* succ;
 
         while (true) {
-            // check if value in list
-            if (!find(value, predecessors, successors)) {
+            // check if key in list
+            if (!find(key, predecessors, successors, guard,
+                      fromPredecessors)) {
 #ifdef COLLECT_STATISTICS
                 SkipListStatistics::threadLocalInstance().deletionFailure();
 #endif
@@ -167,11 +693,14 @@ class LockFreeSkipList final : public SkipList<T>
 #ifdef COLLECT_STATISTICS
                     SkipListStatistics::threadLocalInstance().deletionSuccess();
 #endif
-                    m_size--;
-                    find(value, predecessors,
-                         successors); // clean up, optimization
+                    --m_size;
+                    m_snapshots.labelDelete(nodeToRemove);
+                    find(key, predecessors, successors,
+                         guard); // unlink node from all levels
+                    release(nodeToRemove);
                     return true;
                 } else if (marked) {
+                    m_snapshots.labelDelete(nodeToRemove);
 #ifdef COLLECT_STATISTICS
                     SkipListStatistics::threadLocalInstance().deletionFailure();
 #endif
@@ -181,71 +710,100 @@ class LockFreeSkipList final : public SkipList<T>
         }
     }
 
-    bool contains(const_reference value) override
+    template <typename Visit>
+    bool visit(const key_type& key, Visit visit,
+               std::array<Node*, MaximumHeight>& predecessors,
+               std::array<Node*, MaximumHeight>& successors, Guard& guard,
+               bool fromPredecessors)
     {
 #ifdef COLLECT_STATISTICS
         SkipListStatistics::threadLocalInstance().lookupStart();
 #endif
-        Node* pred = m_head;
-        Node* curr = nullptr;
-        Node* succ = nullptr;
-        bool marked = false;
-
-        for (std::int32_t level = MaximumHeight - 1; level >= 0; --level) {
-            curr = pred->next[level].get(marked);
-            while (true) {
-                succ = curr->next[level].get(marked);
-                // ignore marked nodes
-                while (marked) {
-                    curr = curr->next[level].getReference();
-                    succ = curr->next[level].get(marked);
-                }
-
-                if (curr->value < value) {
-                    pred = curr;
-                    curr = succ;
-                } else {
-                    break;
-                }
-            }
+        const bool found =
+            find(key, predecessors, successors, guard, fromPredecessors);
+        if (found) {
+            m_snapshots.labelInsert(successors[0]);
+            visit(successors[0]->mapped);
         }
-
 #ifdef COLLECT_STATISTICS
         SkipListStatistics::threadLocalInstance().lookupDone();
 #endif
-
-        return (curr->value == value);
+        return found;
     }
 
-    void clear() override
+    /**
+     * Wait-free search of `visitMany`, which skips marked nodes like the one
+     * of `visit`, see interleavedSearch.
+     */
+    template <typename Visit>
+    class InterleavedVisit
     {
-        // TODO not linearizable?
-        bool marked = false;
+      public:
+        using key_type = Key;
+        using Node = typename LockFreeSkipListEngine::Node;
 
-        // mark all nodes (expect of head and sentinel)
-        for (auto* current = m_head->next[0].getReference();
-             current != m_sentinel; current = current->next[0].getReference()) {
-            for (std::int32_t level = current->height; level >= 0; --level) {
-                Node* succ = current->next[level].get(marked);
-                while (!marked) {
-                    current->next[level].compareAndSet(succ, succ, false, true);
-                    succ = current->next[level].get(marked);
-                }
-            }
+        InterleavedVisit(const LockFreeSkipListEngine& engine, Visit& visit)
+            : m_engine(engine)
+            , m_visit(visit)
+        {
         }
 
-        // fully re-connect head with sentinel
-        for (std::uint16_t level = 0; level < MaximumHeight; ++level) {
-            m_head->next[level].set(m_sentinel, false);
+        Node* head() const
+        {
+            return m_engine.m_head;
         }
 
-        m_size = 0;
-    }
+        std::int32_t topLevel() const
+        {
+            return m_engine.m_topLevel.load();
+        }
 
-  private:
-    bool find(const_reference value,
+        Node* next(Node* node, std::int32_t level) const
+        {
+            return node->next[level].getReference();
+        }
+
+        bool isRemoved(Node* node, std::int32_t level) const
+        {
+            return node != m_engine.m_sentinel && node->next[level].marked();
+        }
+
+        bool isBefore(const Node* node, const key_type& key) const
+        {
+            return m_engine.isBefore(node, key);
+        }
+
+        bool found(Node* node, const key_type& key)
+        {
+            if (!m_engine.holds(node, key)) {
+                return false;
+            }
+            m_visit(node->mapped);
+            return true;
+        }
+
+      private:
+        const LockFreeSkipListEngine& m_engine;
+        Visit& m_visit;
+    };
+
+    /**
+     * Searches the levels from the top level hint down, `predecessors` and
+     * `successors` are left untouched above it.
+     * @tparam SkipEqual Stop at the first node greater than `key` instead of
+     * the first node not less than `key`
+     * @param fromPredecessors Start each level at the node in `predecessors`
+     * (the search path of a preceding key) if it precedes `key`, is closer to
+     * it than the predecessor reached from the level above and not marked,
+     * instead of descending from the head only. The predecessors must still
+     * be protected by their hazard slots.
+     * @return true if the node holding `key` has been found
+     */
+    template <bool SkipEqual = false>
+    bool find(const key_type& key,
               std::array<Node*, MaximumHeight>& predecessors,
-              std::array<Node*, MaximumHeight>& successors) const
+              std::array<Node*, MaximumHeight>& successors, Guard& guard,
+              bool fromPredecessors = false)
     {
         bool marked = false;
         Node* pred = nullptr;
@@ -255,58 +813,280 @@ class LockFreeSkipList final : public SkipList<T>
     retry:
         while (true) {
             pred = m_head;
-            for (std::int32_t level = MaximumHeight - 1; level >= 0; --level) {
-                curr = pred->next[level].get(marked);
+            for (std::int32_t level = m_topLevel.load(); level >= 0; --level) {
+                if (fromPredecessors) {
+                    pred = closerPredecessor(pred, predecessors[level], level,
+                                             key);
+                }
+                curr = pred->next[level].getReference();
                 while (true) {
+                    if (!protect(guard, CurrentSlot, pred->next[level], curr)) {
+                        fromPredecessors = false;
+                        goto retry;
+                    }
+
                     succ = curr->next[level].get(marked);
+                    if (Prefetching::Enabled) {
+                        // the nodes compared after `curr`, depending on
+                        // whether the search moves right or descends
+                        Prefetching::node(succ, level);
+                        if (level > 0) {
+                            Prefetching::node(
+                                pred->next[level - 1].getReference(),
+                                level - 1);
+                        }
+                    }
                     // link out marked nodes
-                    while (marked) {
+                    if (marked) {
+                        if (level == 0) {
+                            m_snapshots.logRemoval(curr, [this](Node* node) {
+                                release(node);
+                            });
+                        }
                         if (!pred->next[level].compareAndSet(curr, succ, false,
                                                              false)) {
+                            fromPredecessors = false;
                             goto retry;
                         }
-                        curr = pred->next[level].getReference();
-                        succ = curr->next[level].get(marked);
+                        curr = succ;
+                        continue;
                     }
 
-                    if (curr->value < value) {
+                    if (SkipEqual ? isNotAfter(curr, key)
+                                  : isBefore(curr, key)) {
+                        guard.protect(PredecessorSlot, curr);
                         pred = curr;
                         curr = succ;
                     } else {
                         break;
                     }
                 }
+                guard.protect(predecessorSlot(level), pred);
+                guard.protect(successorSlot(level), curr);
                 predecessors[level] = pred;
                 successors[level] = curr;
             }
-            return (curr->value == value);
+            return holds(curr, key);
+        }
+    }
+
+    /**
+     * Publishes `node` and validates that it is still the unmarked successor
+     * stored in `link`, i.e. that it has not been unlinked in the meantime.
+     * Always succeeds for policies which don't require validation.
+     */
+    static bool protect(Guard& guard, std::size_t slot,
+                        AtomicMarkableReference<Node>& link, Node* node)
+    {
+        if (!Reclamation::RequiresValidation) {
+            return true;
+        }
+
+        guard.protect(slot, node);
+        bool marked = false;
+        return link.get(marked) == node && !marked;
+    }
+
+    static std::size_t predecessorSlot(std::uint16_t level)
+    {
+        return 2 + level;
+    }
+
+    static std::size_t successorSlot(std::uint16_t level)
+    {
+        return 2 + MaximumHeight + level;
+    }
+
+    static std::size_t scanSlot(std::size_t index)
+    {
+        return 2 + 2 * MaximumHeight + index;
+    }
+
+    /**
+     * @return The one of both predecessors of `key` on `level` which is
+     * closer to it, `previous` only if it precedes `key` and is not marked on
+     * that level
+     */
+    Node* closerPredecessor(Node* pred, Node* previous, std::int32_t level,
+                            const key_type& key)
+    {
+        if (previous == m_head || !isBefore(previous, key) ||
+            previous->next[level].marked()) {
+            return pred;
+        }
+        if (pred == m_head || m_compare(pred->key, previous->key)) {
+            return previous;
         }
+        return pred;
+    }
+
+    template <bool SkipEqual>
+    const_iterator bound(const key_type& key)
+    {
+        static_assert(!Reclamation::RequiresValidation,
+                      "Iterators are not supported with hazard pointers");
+        auto guard = createGuard();
+        std::array<Node*, MaximumHeight> predecessors;
+        std::array<Node*, MaximumHeight> successors;
+        find<SkipEqual>(key, predecessors, successors, *guard);
+        return const_iterator(this, skipRemoved(successors[0]),
+                              std::move(guard));
+    }
+
+    std::unique_ptr<Guard> createGuard()
+    {
+        return std::unique_ptr<Guard>(new Guard(m_reclamation));
     }
 
     /**
-     * @return Random height in range [0..MaximumHeight[
+     * @return `node` or the first node behind it which is not marked for
+     * removal
      */
-    static std::uint16_t randomHeight()
+    Node* skipRemoved(Node* node) const
     {
-        std::random_device randomDevice;
-        static thread_local std::mt19937 generator(randomDevice());
-        std::bernoulli_distribution distribution(0.5);
-        const auto flipCoinAndCheckIfHead = [&] {
-            return distribution(generator) == true;
-        };
+        while (node != m_sentinel && node->next[0].marked()) {
+            node = node->next[0].getReference();
+        }
+        return node;
+    }
+
+    Node* nextNode(Node* node) const
+    {
+        return skipRemoved(node->next[0].getReference());
+    }
+
+    /**
+     * Points the given level of a not yet fully linked node to `succ`.
+     * @return false if the node has been marked for removal in the meantime
+     */
+    static bool updateSuccessor(Node* node, std::uint16_t level, Node* succ)
+    {
+        bool marked = false;
+        Node* current = node->next[level].get(marked);
+        while (!marked && current != succ) {
+            // may only fail because the remover marked the link
+            node->next[level].compareAndSet(current, succ, false, false);
+            current = node->next[level].get(marked);
+        }
+        return !marked;
+    }
+
+    /**
+     * @return true if the calling thread marked the bottom level
+     */
+    static bool markAllLevels(Node* node)
+    {
+        bool marked = false;
+        for (std::int32_t level = node->height; level >= 0; --level) {
+            Node* succ = node->next[level].get(marked);
+            while (!marked) {
+                if (node->next[level].compareAndSet(succ, succ, false, true)) {
+                    if (level == 0) {
+                        return true;
+                    }
+                    break;
+                }
+                succ = node->next[level].get(marked);
+            }
+        }
+        return false;
+    }
 
-        std::uint16_t height = 0;
-        while (not flipCoinAndCheckIfHead() and
-               (height < (MaximumHeight - 1))) {
-            ++height;
+    /**
+     * Drops one of the references of inserter, remover and removal log. The
+     * caller must have unlinked the node from all levels if it has been
+     * removed.
+     */
+    void release(Node* node)
+    {
+        if (node->references.fetch_sub(1) == 1) {
+            m_reclamation.retire(node, &reclaimNode, this);
         }
+    }
+
+    static void reclaimNode(void* engine, void* pointer)
+    {
+        auto* node = static_cast<Node*>(pointer);
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().nodeReclaimed(
+            towerNodeSize<Node>(node->height));
+#endif
+        static_cast<LockFreeSkipListEngine*>(engine)->destroyNode(node);
+    }
 
-        assert(height < MaximumHeight);
-        return height;
+    void destroyNode(Node* node)
+    {
+        Storage::release(m_keyArena, node->key);
+        destroyTowerNode(m_allocator, node);
+    }
+
+    /**
+     * @return true if `node` precedes `key`, the sentinel succeeds all keys
+     */
+    bool isBefore(const Node* node, const key_type& key) const
+    {
+        return node != m_sentinel && m_compare(node->key, key);
+    }
+
+    /**
+     * @return true if `node` precedes or holds `key`
+     */
+    bool isNotAfter(const Node* node, const key_type& key) const
+    {
+        return node != m_sentinel && !m_compare(key, node->key);
+    }
+
+    /**
+     * @return true if `node`, which must not precede `key`, holds `key`
+     */
+    bool holds(const Node* node, const key_type& key) const
+    {
+        return isNotAfter(node, key);
+    }
+
+    /**
+     * Destroys all nodes between head and sentinel, requires that no other
+     * thread accesses the list anymore.
+     */
+    void destroyNodes(std::true_type)
+    {
+        m_allocator.releaseAll();
+        Storage::releaseAll(m_keyArena);
+    }
+
+    void destroyNodes(std::false_type)
+    {
+        for (auto* current = m_head->next[0].getReference();
+             current != m_sentinel;) {
+            auto* next = current->next[0].getReference();
+            destroyNode(current);
+            current = next;
+        }
     }
 
   private:
     Node* m_head;
     Node* m_sentinel;
-    std::atomic_size_t m_size;
+    TopLevelHint m_topLevel;
+    ShardedCounter m_size;
+    Compare m_compare;
+    typename Storage::Arena m_keyArena;
+    Allocator m_allocator;
+    typename Snapshots::template Domain<Node> m_snapshots;
+    Reclamation m_reclamation; // frees into m_keyArena, m_allocator
+    typename Finger::template Domain<Node, MaximumHeight> m_finger;
 };
+
+/**
+ * Lock-free skip list set, see LockFreeSkipListEngine for the parameters.
+ */
+template <typename T, std::uint16_t MaximumHeight,
+          typename Reclamation = EpochBasedReclamation,
+          typename Allocator = HeapNodeAllocator,
+          typename HeightGenerator = HalfHeightGenerator,
+          typename Compare = std::less<T>, typename Snapshots = NoSnapshots,
+          typename Finger = NoFinger, typename Prefetching = NoPrefetching>
+using LockFreeSkipList = EngineSkipList<
+    LockFreeSkipListEngine<T, NoMapped, MaximumHeight, Reclamation, Allocator,
+                           HeightGenerator, Compare, Snapshots, Finger,
+                           Prefetching>>;
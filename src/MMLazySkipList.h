@@ -5,16 +5,26 @@
 #include <cassert>
 #include <limits>
 #include <mutex>
-#include <random>
+#include <type_traits>
 
+#include "HeightGenerator.h"
+#include "NodeTower.h"
+#include "ShardedCounter.h"
 #include "SkipList.h"
 #include "SkipListStatistics.h"
 
-template <typename T, std::uint16_t MaximumHeight>
+/**
+ * @tparam HeightGenerator Policy which draws the height of new nodes, e.g.
+ * HalfHeightGenerator, QuarterHeightGenerator or InverseEHeightGenerator
+ */
+template <typename T, std::uint16_t MaximumHeight,
+          typename HeightGenerator = HalfHeightGenerator>
 class MMLazySkipList final : public SkipList<T>
 {
   public:
     static_assert(MaximumHeight > 0, "Maximum height must be greater than 0");
+    // head and sentinel hold the smallest and largest value of T
+    static_assert(std::is_integral<T>::value, "T must be an integral type");
 
     using value_type = typename SkipList<T>::value_type;
     using reference = typename SkipList<T>::reference;
@@ -29,43 +39,56 @@ class MMLazySkipList final : public SkipList<T>
         Node(const_reference value, std::uint16_t height)
             : value(value)
             , height(height)
+            , next(height)
         {
         }
 
         ~Node()
         {
-            for (std::uint16_t i = 0; i < MaximumHeight; ++i) {
-                next[i].reset();
-            }
+            next.destroy(height);
+        }
+
+        static std::shared_ptr<Node> create(const_reference value,
+                                            std::uint16_t height)
+        {
+            return std::shared_ptr<Node>(createTowerNode<Node>(value, height),
+                                         &destroyTowerNode<Node>);
         }
 
         const value_type value;
-        std::array<std::shared_ptr<Node>, MaximumHeight> next;
         const std::uint16_t height;
         std::recursive_mutex mutex;
         volatile bool marked = false;
         volatile bool fullyLinked = false;
+        NodeTower<std::shared_ptr<Node>> next; // must be the last member
     };
 
   public:
     MMLazySkipList()
-        : m_head(std::make_shared<Node>(std::numeric_limits<value_type>::min(),
-                                        MaximumHeight))
-        , m_sentinel(std::make_shared<Node>(
-              std::numeric_limits<value_type>::max(), MaximumHeight))
-        , m_size(0)
+        : m_head(Node::create(std::numeric_limits<value_type>::min(),
+                              MaximumHeight - 1))
+        , m_sentinel(Node::create(std::numeric_limits<value_type>::max(),
+                                  MaximumHeight - 1))
+        , m_size()
     {
-        m_head->next.fill(m_sentinel); // connect head with sentinel
+        for (std::uint16_t level = 0; level < MaximumHeight; ++level) {
+            m_head->next[level] = m_sentinel; // connect head with sentinel
+        }
     }
 
     bool empty() override
     {
-        return m_size == 0;
+        return m_size.value() == 0;
     }
 
     size_type size() override
     {
-        return m_size;
+        return m_size.value();
+    }
+
+    size_type sizeEstimate() override
+    {
+        return m_size.estimate();
     }
 
     bool insert(const_reference value) override
@@ -74,7 +97,8 @@ class MMLazySkipList final : public SkipList<T>
         SkipListStatistics::threadLocalInstance().insertionStart();
 #endif
 
-        const auto newHeight = randomHeight();
+        const auto newHeight =
+            HeightGenerator::template generate<MaximumHeight>();
         std::array<std::shared_ptr<Node>, MaximumHeight> predecessors;
         std::array<std::shared_ptr<Node>, MaximumHeight> successors;
 
@@ -123,8 +147,10 @@ class MMLazySkipList final : public SkipList<T>
             }
 
             // update successors and predecessors
-            const auto newNode = std::make_shared<Node>(value, newHeight);
-            newNode->next = std::move(successors);
+            const auto newNode = Node::create(value, newHeight);
+            for (std::uint16_t level = 0; level <= newHeight; ++level) {
+                newNode->next[level] = std::move(successors[level]);
+            }
             for (std::uint16_t level = 0; level <= newHeight; ++level) {
                 std::atomic_store(&predecessors[level]->next[level], newNode);
             }
@@ -175,7 +201,7 @@ class MMLazySkipList final : public SkipList<T>
                         return false;
                     }
                     node->marked = true; // remove linearization point
-                    m_size--;
+                    --m_size;
                     retryInProgress = true;
                 }
 
@@ -243,18 +269,50 @@ class MMLazySkipList final : public SkipList<T>
                !successors[onLevel]->marked;
     }
 
+    size_type
+    rangeScan(const_reference lo, const_reference hi,
+              const std::function<void(const_reference)>& callback) override
+    {
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupStart();
+#endif
+        std::array<std::shared_ptr<Node>, MaximumHeight> predecessors;
+        std::array<std::shared_ptr<Node>, MaximumHeight> successors;
+        find(lo, predecessors, successors);
+
+        // skip nodes which are not yet inserted or already removed
+        size_type count = 0;
+        for (auto current = successors[0];
+             current != m_sentinel && current->value < hi;
+             current = std::atomic_load(&current->next[0])) {
+            if (current->fullyLinked && !current->marked) {
+                callback(current->value);
+                ++count;
+            }
+        }
+
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupDone();
+#endif
+        return count;
+    }
+
     void clear() override
     {
         std::lock_guard<std::recursive_mutex> lock(m_head->mutex);
 
         // mark all nodes (expect of head and sentinel)
+        std::int64_t markedNodes = 0;
         for (auto current = std::atomic_load(&m_head->next[0]);
              current != m_sentinel;
              current = std::atomic_load(&current->next[0])) {
             while (not current->fullyLinked or current->marked) {
             }
             std::lock_guard<std::recursive_mutex> currentLock(current->mutex);
-            current->marked = true; // ignore if it was marked in the meantime
+            if (not current->marked) { // otherwise counted by the remover
+                current->marked = true;
+                ++markedNodes;
+            }
         }
 
         // fully re-connect head with sentinel
@@ -262,7 +320,7 @@ class MMLazySkipList final : public SkipList<T>
             std::atomic_store(&m_head->next[level], m_sentinel);
         }
 
-        m_size = 0;
+        m_size.add(-markedNodes);
     }
 
   private:
@@ -289,30 +347,8 @@ class MMLazySkipList final : public SkipList<T>
         return foundLevel;
     }
 
-    /**
-     * @return Random height in range [0..MaximumHeight[
-     */
-    static std::uint16_t randomHeight()
-    {
-        std::random_device randomDevice;
-        static thread_local std::mt19937 generator(randomDevice());
-        std::bernoulli_distribution distribution(0.5);
-        const auto flipCoinAndCheckIfHead = [&] {
-            return distribution(generator) == true;
-        };
-
-        std::uint16_t height = 0;
-        while (not flipCoinAndCheckIfHead() and
-               (height < (MaximumHeight - 1))) {
-            ++height;
-        }
-
-        assert(height < MaximumHeight);
-        return height;
-    }
-
   private:
     const std::shared_ptr<Node> m_head;
     const std::shared_ptr<Node> m_sentinel;
-    std::atomic_size_t m_size;
+    ShardedCounter m_size;
 };
@@ -6,17 +6,27 @@
 #include <limits>
 #include <memory>
 #include <mutex>
-#include <random>
+#include <type_traits>
 
+#include "HeightGenerator.h"
 #include "MMAtomicMarkableReference.h"
+#include "NodeTower.h"
+#include "ShardedCounter.h"
 #include "SkipList.h"
 #include "SkipListStatistics.h"
 
-template <typename T, std::uint16_t MaximumHeight>
+/**
+ * @tparam HeightGenerator Policy which draws the height of new nodes, e.g.
+ * HalfHeightGenerator, QuarterHeightGenerator or InverseEHeightGenerator
+ */
+template <typename T, std::uint16_t MaximumHeight,
+          typename HeightGenerator = HalfHeightGenerator>
 class MMLockFreeSkipList final : public SkipList<T>
 {
   public:
     static_assert(MaximumHeight > 0, "Maximum height must be greater than 0");
+    // head and sentinel hold the smallest and largest value of T
+    static_assert(std::is_integral<T>::value, "T must be an integral type");
 
     using value_type = typename SkipList<T>::value_type;
     using reference = typename SkipList<T>::reference;
@@ -31,9 +41,22 @@ class MMLockFreeSkipList final : public SkipList<T>
         Node(const_reference value, std::uint16_t height)
             : value(value)
             , height(height)
+            , next(height)
         {
         }
 
+        ~Node()
+        {
+            next.destroy(height);
+        }
+
+        static std::shared_ptr<Node> create(const_reference value,
+                                            std::uint16_t height)
+        {
+            return std::shared_ptr<Node>(createTowerNode<Node>(value, height),
+                                         &destroyTowerNode<Node>);
+        }
+
         std::shared_ptr<Node> getptr()
         {
             return this->shared_from_this();
@@ -41,16 +64,16 @@ class MMLockFreeSkipList final : public SkipList<T>
 
         const value_type value;
         const std::uint16_t height;
-        std::array<MMAtomicMarkableReference<Node>, MaximumHeight> next;
+        NodeTower<MMAtomicMarkableReference<Node>> next; // must be the last
     };
 
   public:
     MMLockFreeSkipList()
-        : m_head(std::make_shared<Node>(std::numeric_limits<value_type>::min(),
-                                        MaximumHeight - 1))
-        , m_sentinel(std::make_shared<Node>(
-              std::numeric_limits<value_type>::max(), MaximumHeight - 1))
-        , m_size(0)
+        : m_head(Node::create(std::numeric_limits<value_type>::min(),
+                              MaximumHeight - 1))
+        , m_sentinel(Node::create(std::numeric_limits<value_type>::max(),
+                                  MaximumHeight - 1))
+        , m_size()
     {
         for (std::uint16_t level = 0; level <= MaximumHeight - 1; ++level) {
             m_head->next[level].set(m_sentinel.get(), false);
@@ -59,12 +82,17 @@ class MMLockFreeSkipList final : public SkipList<T>
 
     bool empty() override
     {
-        return m_size == 0;
+        return m_size.value() == 0;
     }
 
     size_type size() override
     {
-        return m_size;
+        return m_size.value();
+    }
+
+    size_type sizeEstimate() override
+    {
+        return m_size.estimate();
     }
 
     bool insert(const_reference value) override
@@ -73,7 +101,8 @@ class MMLockFreeSkipList final : public SkipList<T>
         SkipListStatistics::threadLocalInstance().insertionStart();
 #endif
 
-        std::uint16_t topLevel = randomHeight();
+        const std::uint16_t topLevel =
+            HeightGenerator::template generate<MaximumHeight>();
         std::array<Node*, MaximumHeight> predecessors;
         std::array<Node*, MaximumHeight> successors;
 
@@ -87,8 +116,7 @@ class MMLockFreeSkipList final : public SkipList<T>
             }
 
             // prepare new node
-            std::shared_ptr<Node> newNode =
-                std::make_shared<Node>(value, topLevel);
+            std::shared_ptr<Node> newNode = Node::create(value, topLevel);
 
             for (std::uint16_t level = 0; level <= topLevel; ++level) {
                 Node* succ = successors[level];
@@ -105,7 +133,7 @@ class MMLockFreeSkipList final : public SkipList<T>
 #endif
                 continue;
             }
-            m_size++;
+            ++m_size;
 
             // set remaining predecessors
             for (std::uint16_t level = 1; level <= topLevel; ++level) {
@@ -167,7 +195,7 @@ class MMLockFreeSkipList final : public SkipList<T>
 #ifdef COLLECT_STATISTICS
                     SkipListStatistics::threadLocalInstance().deletionSuccess();
 #endif
-                    m_size--;
+                    --m_size;
                     find(value, predecessors,
                          successors); // clean up, optimization
                     return true;
@@ -217,19 +245,52 @@ class MMLockFreeSkipList final : public SkipList<T>
         return (curr->value == value);
     }
 
+    size_type
+    rangeScan(const_reference lo, const_reference hi,
+              const std::function<void(const_reference)>& callback) override
+    {
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupStart();
+#endif
+        std::array<Node*, MaximumHeight> predecessors;
+        std::array<Node*, MaximumHeight> successors;
+        find(lo, predecessors, successors);
+
+        // skip nodes which are logically removed
+        size_type count = 0;
+        for (auto* current = successors[0];
+             current != m_sentinel.get() && current->value < hi;
+             current = current->next[0].getReference()) {
+            if (!current->next[0].marked()) {
+                callback(current->value);
+                ++count;
+            }
+        }
+
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupDone();
+#endif
+        return count;
+    }
+
     void clear() override
     {
         // TODO not linearizable -> use locks?
         bool marked = false;
 
         // mark all nodes (expect of head and sentinel)
+        std::int64_t markedNodes = 0;
         for (auto* current = m_head->next[0].getReference();
              current != m_sentinel.get();
              current = current->next[0].getReference()) {
             for (std::int32_t level = current->height; level >= 0; --level) {
                 Node* succ = current->next[level].get(marked);
                 while (!marked) {
-                    current->next[level].compareAndSet(succ, succ, false, true);
+                    if (current->next[level].compareAndSet(succ, succ, false,
+                                                           true) &&
+                        level == 0) {
+                        ++markedNodes; // otherwise counted by the remover
+                    }
                     succ = current->next[level].get(marked);
                 }
             }
@@ -240,7 +301,7 @@ class MMLockFreeSkipList final : public SkipList<T>
             m_head->next[level].set(m_sentinel.get(), false);
         }
 
-        m_size = 0;
+        m_size.add(-markedNodes);
     }
 
   private:
@@ -284,30 +345,8 @@ class MMLockFreeSkipList final : public SkipList<T>
         }
     }
 
-    /**
-     * @return Random height in range [0..MaximumHeight[
-     */
-    static std::uint16_t randomHeight()
-    {
-        std::random_device randomDevice;
-        static thread_local std::mt19937 generator(randomDevice());
-        std::bernoulli_distribution distribution(0.5);
-        const auto flipCoinAndCheckIfHead = [&] {
-            return distribution(generator) == true;
-        };
-
-        std::uint16_t height = 0;
-        while (not flipCoinAndCheckIfHead() and
-               (height < (MaximumHeight - 1))) {
-            ++height;
-        }
-
-        assert(height < MaximumHeight);
-        return height;
-    }
-
   private:
     const std::shared_ptr<Node> m_head;
     const std::shared_ptr<Node> m_sentinel;
-    std::atomic_size_t m_size;
+    ShardedCounter m_size;
 };
@@ -0,0 +1,616 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "AtomicMarkableReference.h"
+#include "EpochBasedReclamation.h"
+#include "ShardedCounter.h"
+#include "SkipList.h"
+#include "SkipListStatistics.h"
+
+/**
+ * Lock-free skip list without contention hot spots (Crain, Gramoli and
+ * Raynal, 2013): `insert` and `remove` only modify the bottom level, a
+ * dedicated maintenance thread builds the index levels above it.
+ *
+ * The bottom level is a lock-free sorted linked list. `insert` links a new
+ * node with a single CAS (or revives a logically deleted node with the same
+ * value), `remove` only marks the node as deleted. The maintenance thread
+ * periodically
+ *  - lowers the towers of deleted nodes top-down,
+ *  - removes deleted nodes without tower from the bottom level: it marks them
+ *    as removed, freezes their successor (Harris, 2001) and unlinks them,
+ *  - raises a node to the next level if neither it nor its neighbours on its
+ *    current top level have been raised, so that there are one or two nodes
+ *    between two nodes of the next level.
+ *
+ * The index levels have a single writer and consist of separate index nodes,
+ * which the readers follow with acquire loads only. Updating threads help to
+ * unlink removed nodes they come across. Unlinked nodes are freed by
+ * EpochBasedReclamation.
+ *
+ * @tparam Compare Strict weak ordering of the values
+ */
+template <typename T, std::uint16_t MaximumHeight,
+          typename Compare = std::less<T>>
+class NoHotSpotSkipList final : public SkipList<T>
+{
+  public:
+    static_assert(MaximumHeight > 0, "Maximum height must be greater than 0");
+
+    using value_type = typename SkipList<T>::value_type;
+    using reference = typename SkipList<T>::reference;
+    using const_reference = typename SkipList<T>::const_reference;
+    using pointer = typename SkipList<T>::pointer;
+    using const_pointer = typename SkipList<T>::const_pointer;
+    using difference_type = typename SkipList<T>::difference_type;
+    using size_type = typename SkipList<T>::size_type;
+
+  private:
+    enum State : std::uint8_t {
+        Present,
+        Deleted, /**< logically deleted, can be revived by `insert` */
+        Removed  /**< being unlinked by the maintenance thread */
+    };
+
+    struct Node {
+        explicit Node(const_reference value)
+            : value(value)
+            , state(Present)
+            , next(nullptr, false)
+            , height(0)
+        {
+        }
+
+        const value_type value;
+        std::atomic<std::uint8_t> state;
+        AtomicMarkableReference<Node> next; // marked once removed
+        std::uint16_t height; // number of index levels, maintenance only
+    };
+
+    struct Index {
+        Index(Node* node, Index* down)
+            : node(node)
+            , down(down)
+            , right(nullptr)
+        {
+        }
+
+        Node* const node;
+        Index* const down; // nullptr on the lowest index level
+        std::atomic<Index*> right;
+    };
+
+    using Guard = EpochBasedReclamation::Guard;
+
+  public:
+    NoHotSpotSkipList()
+        : m_head(new Node(value_type()))
+        , m_heads()
+        , m_height(0)
+        , m_size()
+        , m_compare()
+        , m_reclamation()
+        , m_maintenanceMutex()
+        , m_stopMutex()
+        , m_stopCondition()
+        , m_stop(false)
+        , m_maintenance()
+    {
+        Index* down = nullptr;
+        for (std::uint16_t level = 1; level < MaximumHeight; ++level) {
+            m_heads[level - 1] = down = new Index(m_head, down);
+        }
+
+        m_maintenance = std::thread([this] { maintainInBackground(); });
+    }
+
+    ~NoHotSpotSkipList()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_stopMutex);
+            m_stop = true;
+        }
+        m_stopCondition.notify_one();
+        m_maintenance.join();
+
+        m_reclamation.reclaimAll();
+        for (auto* head : m_heads) {
+            for (auto* index = head; index != nullptr;) {
+                auto* right = index->right.load();
+                delete index;
+                index = right;
+            }
+        }
+        for (auto* node = m_head; node != nullptr;) {
+            auto* next = node->next.getReference();
+            delete node;
+            node = next;
+        }
+    }
+
+    NoHotSpotSkipList(const NoHotSpotSkipList&) = delete;
+    NoHotSpotSkipList& operator=(const NoHotSpotSkipList&) = delete;
+
+    bool empty() override
+    {
+        return m_size.value() == 0;
+    }
+
+    size_type size() override
+    {
+        return m_size.value();
+    }
+
+    size_type sizeEstimate() override
+    {
+        return m_size.estimate();
+    }
+
+    bool insert(const_reference value) override
+    {
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().insertionStart();
+#endif
+        Guard guard(m_reclamation);
+
+        Node* node = nullptr;
+        while (true) {
+            Node* predecessor;
+            Node* current;
+            find(value, predecessor, current);
+
+            if (holds(current, value)) {
+                std::uint8_t state = Deleted;
+                if (current->state.compare_exchange_strong(state, Present)) {
+                    delete node;
+                    ++m_size;
+#ifdef COLLECT_STATISTICS
+                    SkipListStatistics::threadLocalInstance()
+                        .insertionSuccess();
+#endif
+                    return true;
+                }
+                if (state == Present) {
+                    delete node;
+#ifdef COLLECT_STATISTICS
+                    SkipListStatistics::threadLocalInstance()
+                        .insertionFailure();
+#endif
+                    return false;
+                }
+
+                // the node is being removed, help to unlink it
+                markNext(current);
+            } else {
+                if (node == nullptr) {
+                    node = new Node(value);
+                }
+                node->next.set(current, false);
+                if (predecessor->next.compareAndSet(current, node, false,
+                                                    false)) {
+                    ++m_size;
+#ifdef COLLECT_STATISTICS
+                    SkipListStatistics::threadLocalInstance()
+                        .insertionSuccess();
+#endif
+                    return true;
+                }
+            }
+#ifdef COLLECT_STATISTICS
+            SkipListStatistics::threadLocalInstance().insertionRetry();
+#endif
+        }
+    }
+
+    bool remove(const_reference value) override
+    {
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().deletionStart();
+#endif
+        Guard guard(m_reclamation);
+
+        Node* predecessor;
+        Node* current;
+        find(value, predecessor, current);
+
+        std::uint8_t state = Present;
+        if (!holds(current, value) ||
+            !current->state.compare_exchange_strong(state, Deleted)) {
+#ifdef COLLECT_STATISTICS
+            SkipListStatistics::threadLocalInstance().deletionFailure();
+#endif
+            return false;
+        }
+
+        --m_size;
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().deletionSuccess();
+#endif
+        return true;
+    }
+
+    bool contains(const_reference value) override
+    {
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupStart();
+#endif
+        Guard guard(m_reclamation);
+
+        // removed nodes keep their successor, so they can be traversed
+        Node* current = findPredecessor(value)->next.getReference();
+        while (isBefore(current, value)) {
+            current = current->next.getReference();
+        }
+        const bool found = holds(current, value) &&
+                           current->state.load() == Present;
+
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupDone();
+#endif
+        return found;
+    }
+
+    size_type
+    rangeScan(const_reference lo, const_reference hi,
+              const std::function<void(const_reference)>& callback) override
+    {
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupStart();
+#endif
+        Guard guard(m_reclamation);
+
+        Node* current = findPredecessor(lo)->next.getReference();
+        while (isBefore(current, lo)) {
+            current = current->next.getReference();
+        }
+
+        size_type count = 0;
+        for (; isBefore(current, hi); current = current->next.getReference()) {
+            if (current->state.load() == Present) {
+                callback(current->value);
+                ++count;
+            }
+        }
+
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupDone();
+#endif
+        return count;
+    }
+
+    /**
+     * Deletes all values logically, the maintenance thread removes them.
+     */
+    void clear() override
+    {
+        Guard guard(m_reclamation);
+
+        for (Node* node = m_head->next.getReference(); node != nullptr;
+             node = node->next.getReference()) {
+            std::uint8_t state = Present;
+            if (node->state.compare_exchange_strong(state, Deleted)) {
+                --m_size;
+            }
+        }
+    }
+
+    /**
+     * Runs a maintenance pass in the calling thread, in addition to the
+     * passes of the maintenance thread, e.g. to get a deterministic index in
+     * tests.
+     */
+    void maintain()
+    {
+        std::lock_guard<std::mutex> lock(m_maintenanceMutex);
+        Guard guard(m_reclamation);
+
+        lowerTowers();
+        removeDeletedNodes();
+        raiseBottomLevel();
+        for (std::uint16_t level = 1; level + 1 < MaximumHeight; ++level) {
+            raiseIndexLevel(level);
+        }
+
+        std::uint16_t height = MaximumHeight - 1;
+        while (height > 0 &&
+               m_heads[height - 1]->right.load(std::memory_order_relaxed) ==
+                   nullptr) {
+            --height;
+        }
+        m_height.store(height, std::memory_order_release);
+    }
+
+    /**
+     * @return Number of index levels above the bottom level
+     */
+    std::uint16_t height() const
+    {
+        return m_height.load(std::memory_order_acquire);
+    }
+
+  private:
+    void maintainInBackground()
+    {
+        const auto interval = std::chrono::milliseconds(1);
+
+        std::unique_lock<std::mutex> lock(m_stopMutex);
+        while (!m_stop) {
+            lock.unlock();
+            maintain();
+            lock.lock();
+            m_stopCondition.wait_for(lock, interval, [this] { return m_stop; });
+        }
+    }
+
+    /**
+     * @return Node of the bottom level which precedes `value` (or the head),
+     * found by descending the index
+     */
+    Node* findPredecessor(const_reference value)
+    {
+        const auto height = m_height.load(std::memory_order_acquire);
+        if (height == 0) {
+            return m_head;
+        }
+
+        Index* index = m_heads[height - 1];
+        while (true) {
+            Index* right = index->right.load(std::memory_order_acquire);
+            if (right != nullptr && isBefore(right->node, value)) {
+                index = right;
+            } else if (index->down != nullptr) {
+                index = index->down;
+            } else {
+                return index->node;
+            }
+        }
+    }
+
+    /**
+     * Finds the first node `current` on the bottom level which doesn't
+     * precede `value`, and its unmarked predecessor. Unlinks the removed
+     * nodes in between.
+     */
+    void find(const_reference value, Node*& predecessor, Node*& current)
+    {
+        predecessor = findPredecessor(value);
+        current = predecessor->next.getReference();
+        while (current != nullptr) {
+            bool marked;
+            Node* successor = current->next.get(marked);
+            if (marked) {
+                if (predecessor->next.compareAndSet(current, successor, false,
+                                                    false)) {
+                    retire(current);
+                    current = successor;
+                } else {
+                    // the predecessor has changed, start again
+                    predecessor = findPredecessor(value);
+                    current = predecessor->next.getReference();
+                }
+            } else if (isBefore(current, value)) {
+                predecessor = current;
+                current = successor;
+            } else {
+                return;
+            }
+        }
+    }
+
+    /**
+     * Freezes the successor of a removed node.
+     * @return The successor
+     */
+    static Node* markNext(Node* node)
+    {
+        bool marked;
+        Node* next = node->next.get(marked);
+        while (!marked && !node->next.compareAndSet(next, next, false, true)) {
+            next = node->next.get(marked);
+        }
+        return next;
+    }
+
+    /**
+     * Removes the index nodes of deleted nodes, from the top of their towers
+     * downwards, so that every index node refers to an index node below.
+     */
+    void lowerTowers()
+    {
+        for (std::uint16_t level = MaximumHeight - 1; level > 0; --level) {
+            Index* index = m_heads[level - 1];
+            while (Index* right =
+                       index->right.load(std::memory_order_relaxed)) {
+                Node* node = right->node;
+                if (node->height == level && node->state.load() != Present) {
+                    index->right.store(
+                        right->right.load(std::memory_order_relaxed),
+                        std::memory_order_release);
+                    --node->height;
+                    m_reclamation.retire(right, &reclaimIndex, this);
+                } else {
+                    index = right;
+                }
+            }
+        }
+    }
+
+    /**
+     * Unlinks the deleted nodes without index from the bottom level.
+     */
+    void removeDeletedNodes()
+    {
+        Node* predecessor = m_head;
+        Node* current = predecessor->next.getReference();
+        while (current != nullptr) {
+            bool marked;
+            Node* successor = current->next.get(marked);
+            if (!marked) {
+                std::uint8_t state = Deleted;
+                if (current->height > 0 ||
+                    !current->state.compare_exchange_strong(state, Removed)) {
+                    predecessor = current;
+                    current = successor;
+                    continue;
+                }
+                successor = markNext(current);
+            }
+
+            if (predecessor->next.compareAndSet(current, successor, false,
+                                                false)) {
+                retire(current);
+                current = successor;
+            } else {
+                // a node has been inserted after the predecessor, or another
+                // thread has unlinked the current node
+                current = predecessor->next.getReference();
+            }
+        }
+    }
+
+    /**
+     * Raises every second of the present nodes without index, see
+     * `nextToRaise`.
+     */
+    void raiseBottomLevel()
+    {
+        if (MaximumHeight == 1) {
+            return;
+        }
+
+        Index* last = m_heads[0];
+        bool previousRaised = true;
+        Node* candidate = nullptr;
+        for (Node* node = m_head->next.getReference(); node != nullptr;
+             node = node->next.getReference()) {
+            if (node->state.load() != Present) {
+                continue;
+            }
+            const bool raised = node->height > 0;
+            if (Node* next =
+                    nextToRaise(candidate, previousRaised, node, raised)) {
+                last = link(last, new Index(next, nullptr));
+                next->height = 1;
+            }
+        }
+    }
+
+    /**
+     * Raises every second of the present nodes on index level `level` which
+     * are not on `level + 1`, see `nextToRaise`.
+     */
+    void raiseIndexLevel(std::uint16_t level)
+    {
+        Index* last = m_heads[level];
+        bool previousRaised = true;
+        Index* candidate = nullptr;
+        for (Index* index =
+                 m_heads[level - 1]->right.load(std::memory_order_relaxed);
+             index != nullptr;
+             index = index->right.load(std::memory_order_relaxed)) {
+            if (index->node->state.load() != Present) {
+                continue;
+            }
+            const bool raised = index->node->height > level;
+            if (Index* next =
+                    nextToRaise(candidate, previousRaised, index, raised)) {
+                last = link(last, new Index(next->node, next));
+                next->node->height = level + 1;
+            }
+        }
+    }
+
+    /**
+     * Visits the next item of a level, and returns the preceding one if it
+     * has to be raised: if neither the item, nor its predecessor nor its
+     * successor is on the next level (the head is). So the next level gets
+     * every second of a run of items which are not on it.
+     */
+    template <typename Item>
+    static Item* nextToRaise(Item*& candidate, bool& previousRaised,
+                             Item* item, bool raised)
+    {
+        Item* next = nullptr;
+        if (candidate != nullptr && !raised) {
+            next = candidate;
+            previousRaised = true;
+        }
+        candidate = !previousRaised && !raised ? item : nullptr;
+        previousRaised = raised;
+        return next;
+    }
+
+    /**
+     * Links `index` into the level of `last`, after the last index node
+     * which precedes it.
+     * @return index
+     */
+    Index* link(Index* last, Index* index)
+    {
+        Index* right;
+        while ((right = last->right.load(std::memory_order_relaxed)) !=
+                   nullptr &&
+               m_compare(right->node->value, index->node->value)) {
+            last = right;
+        }
+        index->right.store(right, std::memory_order_relaxed);
+        last->right.store(index, std::memory_order_release);
+        return index;
+    }
+
+    void retire(Node* node)
+    {
+        m_reclamation.retire(node, &reclaimNode, this);
+    }
+
+    static void reclaimNode(void*, void* pointer)
+    {
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().nodeReclaimed(sizeof(Node));
+#endif
+        delete static_cast<Node*>(pointer);
+    }
+
+    static void reclaimIndex(void*, void* pointer)
+    {
+        delete static_cast<Index*>(pointer);
+    }
+
+    /**
+     * @return true if `node` precedes `value`, nullptr succeeds all values
+     */
+    bool isBefore(const Node* node, const_reference value) const
+    {
+        return node != nullptr && m_compare(node->value, value);
+    }
+
+    /**
+     * @return true if `node`, which must not precede `value`, holds `value`
+     */
+    bool holds(const Node* node, const_reference value) const
+    {
+        return node != nullptr && !m_compare(value, node->value);
+    }
+
+  private:
+    Node* m_head;
+    std::array<Index*, MaximumHeight - 1> m_heads; // of the index levels
+    std::atomic<std::uint16_t> m_height;
+    ShardedCounter m_size;
+    Compare m_compare;
+    EpochBasedReclamation m_reclamation;
+
+    std::mutex m_maintenanceMutex; // serializes the passes
+    std::mutex m_stopMutex;
+    std::condition_variable m_stopCondition;
+    bool m_stop;
+    std::thread m_maintenance; // must be the last
+};
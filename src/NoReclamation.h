@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Reclamation policy which never frees retired nodes. Removed nodes are
+ * leaked until the process terminates, serves as baseline for benchmarks.
+ */
+class NoReclamation
+{
+  public:
+    using Deleter = void (*)(void* context, void* pointer);
+
+    class Guard
+    {
+      public:
+        explicit Guard(NoReclamation&)
+        {
+        }
+
+        void protect(std::size_t, const void*)
+        {
+        }
+
+        /**
+         * Nodes are never freed, they all stay valid.
+         */
+        std::uint64_t generation()
+        {
+            return 1;
+        }
+    };
+
+    static constexpr bool RequiresValidation = false;
+
+    void retire(void*, Deleter, void*)
+    {
+    }
+
+    void reclaimAll()
+    {
+    }
+};
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include <sys/mman.h>
+
+#include "PerThread.h"
+
+/**
+ * Allocates every node separately on the global heap.
+ */
+class HeapNodeAllocator
+{
+  public:
+    /**
+     * Nodes have to be deallocated one by one.
+     */
+    static constexpr bool ReleasesAllOnDestruction = false;
+
+    void* allocate(std::uint16_t, std::size_t size)
+    {
+        return ::operator new(size);
+    }
+
+    void deallocate(void* pointer, std::uint16_t, std::size_t)
+    {
+        ::operator delete(pointer);
+    }
+};
+
+/**
+ * Arena allocator with one size class per tower height.
+ *
+ * Each thread carves nodes out of its own chunks and keeps one free list per
+ * height, so neither allocation nor deallocation touches shared state. A node
+ * deallocated by another thread than the allocating one simply moves into the
+ * free list of the deallocating thread.
+ *
+ * All chunks are released at once by `releaseAll` and by the destructor, the
+ * owning list doesn't need to walk its nodes if they are trivially
+ * destructible.
+ *
+ * @tparam UseHugePages Back the chunks by transparent huge pages to reduce TLB
+ * misses (only a hint, ignored if the kernel doesn't support it)
+ * @tparam Tag Distinguishes allocators which are used side by side, each type
+ * caches the per-thread state of the instance it was used with last
+ */
+template <bool UseHugePages = false, typename Tag = void>
+class SlabNodeAllocator
+{
+  public:
+    static constexpr bool ReleasesAllOnDestruction = true;
+
+    static constexpr std::size_t ChunkSize =
+        UseHugePages ? 2 * 1024 * 1024 : 64 * 1024;
+
+  private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    struct ThreadCache {
+        ThreadCache()
+            : current(nullptr)
+            , end(nullptr)
+        {
+        }
+
+        std::vector<FreeNode*> freeLists; /**< indexed by size class */
+        char* current;
+        char* end;
+        std::vector<void*> chunks;
+    };
+
+  public:
+    SlabNodeAllocator() = default;
+
+    ~SlabNodeAllocator()
+    {
+        releaseAll();
+    }
+
+    SlabNodeAllocator(const SlabNodeAllocator&) = delete;
+    SlabNodeAllocator& operator=(const SlabNodeAllocator&) = delete;
+
+    /**
+     * @param sizeClass Blocks of the same size class must have the same size,
+     * the lists use the tower height
+     */
+    void* allocate(std::uint16_t sizeClass, std::size_t size)
+    {
+        auto& cache = m_caches.local();
+        if (sizeClass < cache.freeLists.size() &&
+            cache.freeLists[sizeClass] != nullptr) {
+            auto* node = cache.freeLists[sizeClass];
+            cache.freeLists[sizeClass] = node->next;
+            return node;
+        }
+
+        size = roundUp(size);
+        assert(size <= ChunkSize);
+        if (cache.current == nullptr ||
+            static_cast<std::size_t>(cache.end - cache.current) < size) {
+            cache.current = static_cast<char*>(allocateChunk());
+            cache.end = cache.current + ChunkSize;
+            cache.chunks.push_back(cache.current);
+        }
+
+        void* node = cache.current;
+        cache.current += size;
+        return node;
+    }
+
+    void deallocate(void* pointer, std::uint16_t sizeClass, std::size_t)
+    {
+        auto& cache = m_caches.local();
+        if (sizeClass >= cache.freeLists.size()) {
+            cache.freeLists.resize(sizeClass + 1, nullptr);
+        }
+
+        auto* node = static_cast<FreeNode*>(pointer);
+        node->next = cache.freeLists[sizeClass];
+        cache.freeLists[sizeClass] = node;
+    }
+
+    /**
+     * Frees all chunks, i.e. all nodes ever allocated. Requires that no other
+     * thread uses the allocator concurrently.
+     */
+    void releaseAll()
+    {
+        m_caches.forEach([](ThreadCache& cache) {
+            for (auto* chunk : cache.chunks) {
+                std::free(chunk);
+            }
+            cache.chunks.clear();
+            cache.freeLists.clear();
+            cache.current = nullptr;
+            cache.end = nullptr;
+        });
+    }
+
+  private:
+    static std::size_t roundUp(std::size_t size)
+    {
+        const std::size_t alignment = alignof(std::max_align_t);
+        return (size + alignment - 1) & ~(alignment - 1);
+    }
+
+    static void* allocateChunk()
+    {
+        // huge pages require the chunk to be aligned to the page size
+        const std::size_t alignment = UseHugePages ? ChunkSize : 4096;
+        void* chunk = nullptr;
+        if (posix_memalign(&chunk, alignment, ChunkSize) != 0) {
+            throw std::bad_alloc();
+        }
+#ifdef MADV_HUGEPAGE
+        if (UseHugePages) {
+            madvise(chunk, ChunkSize, MADV_HUGEPAGE);
+        }
+#endif
+        return chunk;
+    }
+
+  private:
+    PerThread<ThreadCache> m_caches;
+};
+
+template <bool UseHugePages, typename Tag>
+constexpr bool SlabNodeAllocator<UseHugePages, Tag>::ReleasesAllOnDestruction;
+
+template <bool UseHugePages, typename Tag>
+constexpr std::size_t SlabNodeAllocator<UseHugePages, Tag>::ChunkSize;
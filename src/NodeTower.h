@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "NodeAllocator.h"
+
+/**
+ * Trailing array of next links of a skip list node.
+ *
+ * Only the bottom link is part of `sizeof(Node)`, the links above are stored
+ * directly behind the node. Therefore the tower must be the last member of the
+ * node and the node must be created with `createTowerNode`, which allocates
+ * exactly `height + 1` links instead of `MaximumHeight`.
+ */
+template <typename Link>
+class NodeTower
+{
+  public:
+    explicit NodeTower(std::uint16_t height)
+    {
+        for (std::uint16_t level = 1; level <= height; ++level) {
+            new (&m_links[level]) Link();
+        }
+    }
+
+    NodeTower(const NodeTower&) = delete;
+    NodeTower& operator=(const NodeTower&) = delete;
+
+    /**
+     * Destroys the links above the bottom one, must be called by the
+     * destructor of the node (the tower does not know its own height).
+     */
+    void destroy(std::uint16_t height)
+    {
+        for (std::uint16_t level = height; level >= 1; --level) {
+            m_links[level].~Link();
+        }
+    }
+
+    Link& operator[](std::size_t level)
+    {
+        return m_links[level];
+    }
+
+    const Link& operator[](std::size_t level) const
+    {
+        return m_links[level];
+    }
+
+  private:
+    Link m_links[1];
+};
+
+/**
+ * @return Number of bytes occupied by a node with a tower of `height + 1`
+ * links
+ */
+template <typename Node>
+std::size_t towerNodeSize(std::uint16_t height)
+{
+    return sizeof(Node) + height * sizeof(std::declval<Node&>().next[0]);
+}
+
+template <typename Node, typename Allocator, typename Value>
+Node* createTowerNode(Allocator& allocator, const Value& value,
+                      std::uint16_t height)
+{
+    void* memory = allocator.allocate(height, towerNodeSize<Node>(height));
+    return new (memory) Node(value, height);
+}
+
+template <typename Allocator, typename Node>
+void destroyTowerNode(Allocator& allocator, Node* node)
+{
+    const auto height = node->height;
+    node->~Node();
+    allocator.deallocate(node, height, towerNodeSize<Node>(height));
+}
+
+template <typename Node, typename Value>
+Node* createTowerNode(const Value& value, std::uint16_t height)
+{
+    HeapNodeAllocator allocator;
+    return createTowerNode<Node>(allocator, value, height);
+}
+
+template <typename Node>
+void destroyTowerNode(Node* node)
+{
+    HeapNodeAllocator allocator;
+    destroyTowerNode(allocator, node);
+}
@@ -0,0 +1,282 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "SkipList.h"
+
+/**
+ * Skip list which splits the key space into ranges, each of which is held by
+ * its own `Inner` list (a shard). Threads which work on different ranges
+ * don't meet in the head tower and upper levels of a single list, and each
+ * shard is shallower than a single list of all values.
+ *
+ * Shard `i` holds the values in [boundaries[i - 1], boundaries[i]), the first
+ * and last shard are unbounded below and above respectively. Operations are
+ * routed by a binary search in the boundaries, batches and bulk loads are
+ * split into the runs of their values per shard, `containsMany` groups its
+ * values by shard, and range scans visit the shards in order. Concurrent
+ * operations are as safe as those of `Inner`, `size()` and `empty()` are as
+ * consistent as summing up the shards allows.
+ *
+ * @tparam Inner Any SkipList<T> implementation which is default constructible
+ * @tparam Compare Order of the values, must match the one of `Inner`
+ */
+template <typename Inner,
+          typename Compare = std::less<typename Inner::value_type>>
+class PartitionedSkipList final : public SkipList<typename Inner::value_type>
+{
+  private:
+    using Base = SkipList<typename Inner::value_type>;
+
+  public:
+    using value_type = typename Base::value_type;
+    using reference = typename Base::reference;
+    using const_reference = typename Base::const_reference;
+    using pointer = typename Base::pointer;
+    using const_pointer = typename Base::const_pointer;
+    using difference_type = typename Base::difference_type;
+    using size_type = typename Base::size_type;
+
+  public:
+    /**
+     * @param boundaries Ascending lower bounds of the shards except the first
+     */
+    explicit PartitionedSkipList(std::vector<value_type> boundaries)
+        : m_boundaries(std::move(boundaries))
+        , m_shards()
+        , m_compare()
+    {
+        m_shards.reserve(m_boundaries.size() + 1);
+        for (size_type i = 0; i <= m_boundaries.size(); ++i) {
+            m_shards.emplace_back(new Inner());
+        }
+    }
+
+    /**
+     * @return Boundaries which split [lo, hi) into `numberOfShards` ranges of
+     * equal width, for arithmetic values
+     */
+    static std::vector<value_type>
+    evenBoundaries(const_reference lo, const_reference hi,
+                   size_type numberOfShards)
+    {
+        static_assert(std::is_arithmetic<value_type>::value,
+                      "Only arithmetic values can be split evenly");
+
+        std::vector<value_type> boundaries;
+        for (size_type i = 1; i < numberOfShards; ++i) {
+            boundaries.push_back(lo + (hi - lo) * i / numberOfShards);
+        }
+        return boundaries;
+    }
+
+    size_type numberOfShards() const
+    {
+        return m_shards.size();
+    }
+
+    bool empty() override
+    {
+        for (auto& shard : m_shards) {
+            if (!shard->empty()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_type size() override
+    {
+        size_type size = 0;
+        for (auto& shard : m_shards) {
+            size += shard->size();
+        }
+        return size;
+    }
+
+    size_type sizeEstimate() override
+    {
+        size_type size = 0;
+        for (auto& shard : m_shards) {
+            size += shard->sizeEstimate();
+        }
+        return size;
+    }
+
+    bool insert(const_reference value) override
+    {
+        return shardOf(value).insert(value);
+    }
+
+    bool remove(const_reference value) override
+    {
+        return shardOf(value).remove(value);
+    }
+
+    bool contains(const_reference value) override
+    {
+        return shardOf(value).contains(value);
+    }
+
+    size_type insertBatch(const_pointer first, const_pointer last,
+                          bool* results) override
+    {
+        return forEachRun(first, last,
+                          [results, first](Inner& shard, const_pointer begin,
+                                           const_pointer end) {
+                              return shard.insertBatch(
+                                  begin, end, results + (begin - first));
+                          });
+    }
+
+    size_type removeBatch(const_pointer first, const_pointer last,
+                          bool* results) override
+    {
+        return forEachRun(first, last,
+                          [results, first](Inner& shard, const_pointer begin,
+                                           const_pointer end) {
+                              return shard.removeBatch(
+                                  begin, end, results + (begin - first));
+                          });
+    }
+
+    size_type containsBatch(const_pointer first, const_pointer last,
+                            bool* results) override
+    {
+        return forEachRun(first, last,
+                          [results, first](Inner& shard, const_pointer begin,
+                                           const_pointer end) {
+                              return shard.containsBatch(
+                                  begin, end, results + (begin - first));
+                          });
+    }
+
+    /**
+     * The values are looked up in any order, so they are grouped by shard
+     * instead of split into runs: the searches of a shard's group are
+     * interleaved even if its values are scattered over [first, last).
+     */
+    size_type containsMany(const_pointer first, const_pointer last,
+                           bool* results) override
+    {
+        const auto count = static_cast<size_type>(last - first);
+        std::vector<size_type> shards(count);
+        std::vector<size_type> offsets(m_shards.size() + 1, 0);
+        for (size_type i = 0; i < count; ++i) {
+            shards[i] = shardIndexOf(first[i]);
+            ++offsets[shards[i] + 1];
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        // counting sort by shard, remembering the position of each value
+        std::vector<value_type> grouped(count);
+        std::vector<size_type> positions(count);
+        auto next = offsets;
+        for (size_type i = 0; i < count; ++i) {
+            const auto position = next[shards[i]]++;
+            grouped[position] = first[i];
+            positions[position] = i;
+        }
+
+        std::unique_ptr<bool[]> groupedResults(new bool[count]);
+        size_type found = 0;
+        for (size_type shard = 0; shard < m_shards.size(); ++shard) {
+            if (offsets[shard] != offsets[shard + 1]) {
+                found += m_shards[shard]->containsMany(
+                    grouped.data() + offsets[shard],
+                    grouped.data() + offsets[shard + 1],
+                    groupedResults.get() + offsets[shard]);
+            }
+        }
+        for (size_type position = 0; position < count; ++position) {
+            results[positions[position]] = groupedResults[position];
+        }
+        return found;
+    }
+
+    size_type bulkLoad(const_pointer first, const_pointer last) override
+    {
+        return forEachRun(
+            first, last,
+            [](Inner& shard, const_pointer begin, const_pointer end) {
+                return shard.bulkLoad(begin, end);
+            });
+    }
+
+    size_type
+    rangeScan(const_reference lo, const_reference hi,
+              const std::function<void(const_reference)>& callback) override
+    {
+        if (!m_compare(lo, hi)) {
+            return 0;
+        }
+
+        size_type count = 0;
+        const auto lastShard = shardIndexOf(hi);
+        for (auto i = shardIndexOf(lo); i <= lastShard; ++i) {
+            count += m_shards[i]->rangeScan(lo, hi, callback);
+        }
+        return count;
+    }
+
+    void clear() override
+    {
+        for (auto& shard : m_shards) {
+            shard->clear();
+        }
+    }
+
+  private:
+    size_type shardIndexOf(const_reference value) const
+    {
+        return std::upper_bound(m_boundaries.begin(), m_boundaries.end(),
+                                value, m_compare) -
+               m_boundaries.begin();
+    }
+
+    Inner& shardOf(const_reference value)
+    {
+        return *m_shards[shardIndexOf(value)];
+    }
+
+    /**
+     * Splits [first, last) into the runs of consecutive values which belong
+     * to the same shard and calls `function(shard, begin, end)` for each of
+     * them. A sorted range has at most one run per shard.
+     * @return Sum of the results of `function`
+     */
+    template <typename Function>
+    size_type forEachRun(const_pointer first, const_pointer last,
+                         Function function)
+    {
+        size_type count = 0;
+        while (first != last) {
+            const auto shard = shardIndexOf(*first);
+            auto end = first + 1;
+            while (end != last && isInShard(*end, shard)) {
+                ++end;
+            }
+            count += function(*m_shards[shard], first, end);
+            first = end;
+        }
+        return count;
+    }
+
+    bool isInShard(const_reference value, size_type shard) const
+    {
+        return (shard == 0 || !m_compare(value, m_boundaries[shard - 1])) &&
+               (shard == m_boundaries.size() ||
+                m_compare(value, m_boundaries[shard]));
+    }
+
+  private:
+    const std::vector<value_type> m_boundaries; // routing table
+    std::vector<std::unique_ptr<Inner>> m_shards;
+    Compare m_compare;
+};
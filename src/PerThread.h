@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+/**
+ * One lazily created `Record` per thread and owning object (e.g. per thread
+ * and list), in contrast to `thread_local` which is per thread only.
+ *
+ * Records are never removed before the owning object is destroyed, a record
+ * of a terminated thread is taken over by the next thread with the same id.
+ * All records can be visited by any thread, so records must only contain
+ * members which are safe to be read concurrently by other threads.
+ */
+template <typename Record>
+class PerThread
+{
+  private:
+    // objects of the same record type whose records are cached per thread
+    static const std::size_t CacheSlots = 8;
+
+    struct Entry {
+        Entry(std::thread::id owner)
+            : record()
+            , owner(owner)
+            , next(nullptr)
+        {
+        }
+
+        Record record;
+        const std::thread::id owner;
+        Entry* next;
+    };
+
+  public:
+    PerThread()
+        : m_id(nextId()++)
+        , m_entries(nullptr)
+        , m_size(0)
+    {
+    }
+
+    ~PerThread()
+    {
+        for (auto* entry = m_entries.load(); entry != nullptr;) {
+            auto* next = entry->next;
+            delete entry;
+            entry = next;
+        }
+    }
+
+    PerThread(const PerThread&) = delete;
+    PerThread& operator=(const PerThread&) = delete;
+
+    /**
+     * @return Record of the calling thread
+     */
+    Record& local()
+    {
+        // threads mostly work on a few objects at a time (e.g. the shards of
+        // a partitioned list, each with its own records), so a direct-mapped
+        // cache of the recently used objects avoids the lookup. Ids are never
+        // reused, an entry of a destroyed object is never hit.
+        struct CachedEntry {
+            std::uint64_t id;
+            Entry* entry;
+        };
+        static thread_local CachedEntry cache[CacheSlots] = {};
+
+        auto& cached = cache[m_id % CacheSlots];
+        if (cached.id != m_id) {
+            cached.entry = &acquire();
+            cached.id = m_id;
+        }
+        return cached.entry->record;
+    }
+
+    /**
+     * Calls `function(record)` for the records of all threads.
+     */
+    template <typename Function>
+    void forEach(Function function)
+    {
+        for (auto* entry = m_entries.load(); entry != nullptr;
+             entry = entry->next) {
+            function(entry->record);
+        }
+    }
+
+    template <typename Function>
+    void forEach(Function function) const
+    {
+        for (const auto* entry = m_entries.load(); entry != nullptr;
+             entry = entry->next) {
+            function(entry->record);
+        }
+    }
+
+    /**
+     * @return Number of threads which have a record
+     */
+    std::size_t size() const
+    {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+  private:
+    Entry& acquire()
+    {
+        const auto self = std::this_thread::get_id();
+
+        // thread ids are unique among running threads, so an entry owned by
+        // the id of a terminated thread can safely be taken over
+        for (auto* entry = m_entries.load(); entry != nullptr;
+             entry = entry->next) {
+            if (entry->owner == self) {
+                return *entry;
+            }
+        }
+
+        auto* entry = new Entry(self);
+        entry->next = m_entries.load();
+        while (!m_entries.compare_exchange_weak(entry->next, entry)) {
+        }
+        ++m_size;
+        return *entry;
+    }
+
+    static std::atomic<std::uint64_t>& nextId()
+    {
+        static std::atomic<std::uint64_t> id(1);
+        return id;
+    }
+
+  private:
+    const std::uint64_t m_id;
+    std::atomic<Entry*> m_entries;
+    std::atomic<std::size_t> m_size;
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Prefetching policy of LazySkipList and LockFreeSkipList which leaves the
+ * loads of a search to the processor.
+ */
+struct NoPrefetching {
+    static constexpr bool Enabled = false;
+
+    template <typename Node>
+    static void node(const Node*, std::uint16_t)
+    {
+    }
+};
+
+/**
+ * Prefetching policy which lets the search request the nodes it may compare
+ * next while it is still comparing the current one: the successor of the
+ * current node if the search moves right and the successor of the
+ * predecessor on the level below if it descends. Which of both is needed
+ * hardly follows a pattern, so the processor often speculates on the wrong
+ * one. Pays off once the list exceeds the caches, costs a few instructions
+ * per step otherwise.
+ */
+struct SuccessorPrefetching {
+    static constexpr bool Enabled = true;
+
+    /**
+     * Prefetches the key of `node` and its link on `level`, nothing if
+     * `node` is nullptr. Never faults, even for freed nodes.
+     */
+    template <typename Node>
+    static void node(const Node* node, std::uint16_t level)
+    {
+        if (node != nullptr) {
+            __builtin_prefetch(node);
+            __builtin_prefetch(&node->next[level]);
+        }
+    }
+};
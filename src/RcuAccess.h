@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+
+#include "EpochBasedReclamation.h"
+
+/**
+ * Access policy of SequentialSkipList which requires that all operations are
+ * serialized, e.g. by a mutex. Removed nodes are freed at once.
+ */
+struct ExclusiveAccess {
+    static constexpr bool ConcurrentReaders = false;
+
+    /**
+     * Field which is written by the writer and read by the readers.
+     */
+    template <typename T>
+    using Shared = T;
+
+    class Domain
+    {
+      public:
+        using Deleter = void (*)(void* context, void* pointer);
+
+        void retire(void* pointer, Deleter deleter, void* context)
+        {
+            deleter(context, pointer);
+        }
+
+        void reclaimAll()
+        {
+        }
+    };
+
+    class Guard
+    {
+      public:
+        explicit Guard(Domain&)
+        {
+        }
+    };
+};
+
+/**
+ * Access policy of SequentialSkipList which lets readers traverse the list
+ * without any lock while a single writer (at a time) modifies it, like
+ * read-copy-update. The writer initializes a node completely before it
+ * publishes the node with release stores, and removed nodes are freed only
+ * once no reader can still be inside them (EpochBasedReclamation).
+ */
+struct RcuAccess {
+    static constexpr bool ConcurrentReaders = true;
+
+    template <typename T>
+    using Shared = std::atomic<T>;
+
+    using Domain = EpochBasedReclamation;
+    using Guard = EpochGuard;
+};
+
+template <typename T>
+T loadShared(const T& field)
+{
+    return field;
+}
+
+template <typename T>
+T loadShared(const std::atomic<T>& field)
+{
+    return field.load(std::memory_order_acquire);
+}
+
+template <typename T>
+void storeShared(T& field, T value)
+{
+    field = value;
+}
+
+template <typename T>
+void storeShared(std::atomic<T>& field, T value)
+{
+    field.store(value, std::memory_order_release);
+}
@@ -2,17 +2,54 @@
 
 #include <array>
 #include <cassert>
-#include <limits>
-#include <random>
-
+#include <functional>
+#include <type_traits>
+
+#include "BulkLoad.h"
+#include "FingerSearch.h"
+#include "HeightGenerator.h"
+#include "InterleavedSearch.h"
+#include "KeyStorage.h"
+#include "NodeAllocator.h"
+#include "NodeTower.h"
+#include "RcuAccess.h"
 #include "SkipList.h"
 #include "SkipListStatistics.h"
-
-template <typename T, std::uint16_t MaximumHeight>
+#include "SuccessorKeys.h"
+
+/**
+ * @tparam Allocator Provides the memory of the nodes, HeapNodeAllocator or
+ * SlabNodeAllocator
+ * @tparam HeightGenerator Policy which draws the height of new nodes, e.g.
+ * HalfHeightGenerator, QuarterHeightGenerator or InverseEHeightGenerator
+ * @tparam Compare Strict weak ordering of the values, head and sentinel are
+ * compared by address and don't need a smallest or largest value
+ * @tparam Finger NoFinger or ThreadFinger, which starts every search from
+ * the search path of the previous operation
+ * @tparam Access ExclusiveAccess or RcuAccess, which allows `contains`,
+ * `containsBatch`, `rangeScan`, `size` and `empty` to run concurrently with
+ * each other and with one modifying operation
+ * @tparam SuccessorKeys NoSuccessorKeys or CachedSuccessorKeys, which stores
+ * the value of the successor in every tower slot, only with ExclusiveAccess
+ */
+template <typename T, std::uint16_t MaximumHeight,
+          typename Allocator = HeapNodeAllocator,
+          typename HeightGenerator = HalfHeightGenerator,
+          typename Compare = std::less<T>, typename Finger = NoFinger,
+          typename Access = ExclusiveAccess,
+          typename SuccessorKeys = NoSuccessorKeys>
 class SequentialSkipList final : public SkipList<T>
 {
   public:
     static_assert(MaximumHeight > 0, "Maximum height must be greater than 0");
+    static_assert(!Access::ConcurrentReaders || !Finger::Enabled,
+                  "Lookups of concurrent readers can't move the finger");
+    static_assert(!Access::ConcurrentReaders || !SuccessorKeys::Enabled,
+                  "Concurrent readers can't read pointer and value of a "
+                  "link at once");
+    static_assert(!SuccessorKeys::Enabled ||
+                      std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable values can be cached in links");
 
     using value_type = typename SkipList<T>::value_type;
     using reference = typename SkipList<T>::reference;
@@ -23,92 +60,360 @@ class SequentialSkipList final : public SkipList<T>
     using size_type = typename SkipList<T>::size_type;
 
   private:
+    struct Node;
+
+    using Link = typename SuccessorKeys::template Link<
+        Node, T, typename Access::template Shared<Node*>>;
+
     struct Node {
         Node(const_reference value, std::uint16_t height)
             : value(value)
             , height(height)
+            , next(height)
         {
 #ifndef NDEBUG
             // if stack trace contains coffee, then there went something
             // somewhere terrible wrong
-            next.fill(reinterpret_cast<Node*>(0xC0FFEE));
+            for (std::uint16_t level = 0; level <= height; ++level) {
+                poison(next[level]);
+            }
 #endif
         }
 
         const value_type value;
-        std::array<Node*, MaximumHeight> next;
         const std::uint16_t height;
+        NodeTower<Link> next; // must be the last member
+    };
+
+    using Storage = KeyStorage<value_type>;
+    using Guard = typename Access::Guard;
+
+    // the allocator can drop all nodes at once, no need to visit them
+    static constexpr bool ReleasesAllNodesAtOnce =
+        Allocator::ReleasesAllOnDestruction &&
+        std::is_trivially_destructible<Node>::value;
+
+  public:
+    /**
+     * Sequence of operations on ascending values, each of which continues
+     * from the search path of the preceding one instead of starting at the
+     * head again (see `insertBatch`). Operations on descending values are
+     * correct too, but not faster. The sweep must not outlive the list and
+     * no other operation must modify the list meanwhile.
+     */
+    class Sweep
+    {
+      public:
+        explicit Sweep(SequentialSkipList& list)
+            : m_list(list)
+        {
+            m_predecessors.fill(list.m_head);
+        }
+
+        bool insert(const_reference value)
+        {
+            return m_list.insert(value, m_predecessors, true);
+        }
+
+        bool remove(const_reference value)
+        {
+            return m_list.remove(value, m_predecessors, true);
+        }
+
+        bool contains(const_reference value)
+        {
+#ifdef COLLECT_STATISTICS
+            SkipListStatistics::threadLocalInstance().lookupStart();
+#endif
+            const bool found = m_list.holds(
+                m_list.searchFromPredecessors(value, m_predecessors), value);
+#ifdef COLLECT_STATISTICS
+            SkipListStatistics::threadLocalInstance().lookupDone();
+#endif
+            return found;
+        }
+
+      private:
+        SequentialSkipList& m_list;
+        std::array<Node*, MaximumHeight> m_predecessors;
     };
 
   public:
     SequentialSkipList()
-        : m_head(
-              new Node(std::numeric_limits<value_type>::min(), MaximumHeight))
-        , m_sentinel(
-              new Node(std::numeric_limits<value_type>::max(), MaximumHeight))
+        : m_head(createTowerNode<Node>(value_type(), MaximumHeight - 1))
+        , m_sentinel(createTowerNode<Node>(value_type(), MaximumHeight - 1))
+        , m_finger()
         , m_height(0)
         , m_size(0)
+        , m_compare()
+        , m_keyArena()
+        , m_allocator()
+        , m_domain()
     {
-        m_head->next.fill(m_sentinel); // connect head with sentinel
-        m_sentinel->next.fill(nullptr);
+        for (std::uint16_t level = 0; level < MaximumHeight; ++level) {
+            link(m_head, level, m_sentinel); // connect head with sentinel
+            link(m_sentinel, level, nullptr);
+        }
+        m_finger.fill(m_head);
 
         checkConsistency();
     }
 
     ~SequentialSkipList() override
     {
-        for (auto* current = m_head; current != nullptr;) {
-            auto* next = current->next[0];
-            delete current;
-            current = next;
-        }
+        // pending nodes must be freed before the allocator drops them
+        m_domain.reclaimAll();
+        destroyNodes();
+
+        // head and sentinel are not part of the allocator
+        destroyTowerNode(m_head);
+        destroyTowerNode(m_sentinel);
     }
 
     bool empty() override
     {
-        return m_size == 0;
+        return loadShared(m_size) == 0;
     }
 
     size_type size() override
     {
-        return m_size;
+        return loadShared(m_size);
     }
 
     bool insert(const_reference value) override
     {
+        Guard guard(m_domain);
+        if (Finger::Enabled) {
+            return insert(value, m_finger, true);
+        }
+        std::array<Node*, MaximumHeight> predecessors;
+        return insert(value, predecessors, false);
+    }
+
+    bool remove(const_reference value) override
+    {
+        Guard guard(m_domain);
+        if (Finger::Enabled) {
+            return remove(value, m_finger, true);
+        }
+        std::array<Node*, MaximumHeight> predecessors;
+        return remove(value, predecessors, false);
+    }
+
+    bool contains(const_reference value) override
+    {
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupStart();
+#endif
+        Guard guard(m_domain);
+
+        auto* current = Finger::Enabled
+                            ? searchFromPredecessors(value, m_finger)
+                            : lowerBound(value);
+
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupDone();
+#endif
+
+        return holds(current, value);
+    }
+
+    size_type insertBatch(const_pointer first, const_pointer last,
+                          bool* results) override
+    {
+        Guard guard(m_domain);
+        Sweep sweep(*this);
+        size_type count = 0;
+        for (; first != last; ++first, ++results) {
+            *results = sweep.insert(*first);
+            count += *results ? 1 : 0;
+        }
+        return count;
+    }
+
+    size_type removeBatch(const_pointer first, const_pointer last,
+                          bool* results) override
+    {
+        Guard guard(m_domain);
+        Sweep sweep(*this);
+        size_type count = 0;
+        for (; first != last; ++first, ++results) {
+            *results = sweep.remove(*first);
+            count += *results ? 1 : 0;
+        }
+        return count;
+    }
+
+    size_type containsBatch(const_pointer first, const_pointer last,
+                            bool* results) override
+    {
+        Guard guard(m_domain);
+        Sweep sweep(*this);
+        size_type count = 0;
+        for (; first != last; ++first, ++results) {
+            *results = sweep.contains(*first);
+            count += *results ? 1 : 0;
+        }
+        return count;
+    }
+
+    size_type containsMany(const_pointer first, const_pointer last,
+                           bool* results) override
+    {
+        Guard guard(m_domain);
+        InterleavedLookup search(*this);
+        return interleavedSearch(search, first, last, results);
+    }
+
+    size_type bulkLoad(const_pointer first, const_pointer last) override
+    {
+        if (loadShared(m_size) != 0) {
+            return SkipList<T>::bulkLoad(first, last);
+        }
+
+        // concurrent readers must not see the towers before they are linked
+        // completely, they are built behind a private head then
+        auto* head =
+            Access::ConcurrentReaders
+                ? createTowerNode<Node>(value_type(), MaximumHeight - 1)
+                : m_head;
+        const auto result = BulkLoader<Node, MaximumHeight, HeightGenerator>::
+            load(head, m_sentinel, first, last,
+                 [](const_reference value) -> const_reference {
+                     return value;
+                 },
+                 m_compare,
+                 [this](const_pointer value, std::uint16_t height) {
+                     return createTowerNode<Node>(
+                         m_allocator, Storage::store(m_keyArena, *value),
+                         height);
+                 },
+                 [](Node* pred, std::uint16_t level, Node* succ) {
+                     link(pred, level, succ);
+                 });
+        if (head != m_head) {
+            for (std::uint16_t level = 0; level < MaximumHeight; ++level) {
+                link(m_head, level, successor(head, level));
+            }
+            destroyTowerNode(head);
+        }
+        storeShared(m_size, result.count);
+        storeShared(m_height, result.height);
+        m_finger.fill(m_head);
+
+        checkConsistency();
+
+        return result.count;
+    }
+
+    size_type
+    rangeScan(const_reference lo, const_reference hi,
+              const std::function<void(const_reference)>& callback) override
+    {
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupStart();
+#endif
+        Guard guard(m_domain);
+
+        size_type count = 0;
+        for (auto* current = lowerBound(lo); isBefore(current, hi);
+             current = successor(current, 0)) {
+            callback(current->value);
+            ++count;
+        }
+
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupDone();
+#endif
+
+        return count;
+    }
+
+    void clear() override
+    {
+        Guard guard(m_domain);
+        auto* first = successor(m_head, 0);
+
+        // remove all nodes between head and sentinel, unless concurrent
+        // readers might still be inside them
+        if (!Access::ConcurrentReaders) {
+            destroyNodes();
+        }
+
+        // set all changed next pointers of head node back to sentinel node
+        for (std::uint16_t level = 0; level <= loadShared(m_height); ++level) {
+            link(m_head, level, m_sentinel);
+        }
+
+        if (Access::ConcurrentReaders) {
+            for (auto* current = first; current != m_sentinel;) {
+                auto* next = successor(current, 0);
+                m_domain.retire(current, &reclaimNode, this);
+                current = next;
+            }
+        }
+
+        storeShared<size_type>(m_size, 0);
+        storeShared<std::uint16_t>(m_height, 0);
+        m_finger.fill(m_head);
+
+        checkConsistency();
+    }
+
+  private:
+    /**
+     * @param fromPredecessors Continue the search from `predecessors`, which
+     * hold the search path of a preceding value (see
+     * `searchFromPredecessors`)
+     */
+    bool insert(const_reference value,
+                std::array<Node*, MaximumHeight>& predecessors,
+                bool fromPredecessors)
+    {
 #ifdef COLLECT_STATISTICS
         SkipListStatistics::threadLocalInstance().insertionStart();
 #endif
 
-        std::array<Node*, MaximumHeight> predecessors;
-        auto* current = searchNodeAndRememberPredecessors(value, predecessors);
-        if (current->value == value) { // already in list
+        auto* current =
+            fromPredecessors
+                ? searchFromPredecessors(value, predecessors)
+                : searchNodeAndRememberPredecessors(value, predecessors);
+        if (holds(current, value)) { // already in list
 #ifdef COLLECT_STATISTICS
             SkipListStatistics::threadLocalInstance().insertionFailure();
 #endif
             return false;
         }
 
-        const auto newHeight = randomHeight();
-        if (newHeight > m_height) {
+        const auto newHeight =
+            HeightGenerator::template generate<MaximumHeight>();
+        const auto height = loadShared(m_height);
+        if (newHeight > height) {
             // new node is higher than all other inserted nodes, connect slots
             // above current max. height with head node
-            for (std::uint16_t level = m_height + 1; level <= newHeight;
+            for (std::uint16_t level = height + 1; level <= newHeight;
                  ++level) {
                 predecessors[level] = m_head;
             }
-            m_height = newHeight;
+            storeShared<std::uint16_t>(m_height, newHeight);
         }
 
         // add a new node between predecessors and the predecessors's
-        // postdecessors
-        auto* newNode = new Node(value, newHeight);
+        // postdecessors, each level of the new node is complete before it is
+        // published on that level
+        auto* newNode = createTowerNode<Node>(
+            m_allocator, Storage::store(m_keyArena, value), newHeight);
         for (std::uint16_t level = 0; level <= newHeight; ++level) {
-            newNode->next[level] = predecessors[level]->next[level];
-            predecessors[level]->next[level] = newNode;
+            link(newNode, level, successor(predecessors[level], level));
+            link(predecessors[level], level, newNode);
+            if (fromPredecessors) {
+                // a following value behind the new node continues from it,
+                // which makes appending at the tail a constant time search
+                predecessors[level] = newNode;
+            }
         }
 
-        ++m_size;
+        storeShared<size_type>(m_size, loadShared(m_size) + 1);
 
         checkConsistency();
 
@@ -119,15 +424,19 @@ class SequentialSkipList final : public SkipList<T>
         return true;
     }
 
-    bool remove(const_reference value) override
+    bool remove(const_reference value,
+                std::array<Node*, MaximumHeight>& predecessors,
+                bool fromPredecessors)
     {
 #ifdef COLLECT_STATISTICS
         SkipListStatistics::threadLocalInstance().deletionStart();
 #endif
 
-        std::array<Node*, MaximumHeight> predecessors;
-        auto* current = searchNodeAndRememberPredecessors(value, predecessors);
-        if (current->value != value) { // not in list
+        auto* current =
+            fromPredecessors
+                ? searchFromPredecessors(value, predecessors)
+                : searchNodeAndRememberPredecessors(value, predecessors);
+        if (!holds(current, value)) { // not in list
 #ifdef COLLECT_STATISTICS
             SkipListStatistics::threadLocalInstance().deletionFailure();
 #endif
@@ -136,22 +445,22 @@ class SequentialSkipList final : public SkipList<T>
 
         const auto nodeHeight = current->height;
         for (std::uint16_t level = 0; level <= nodeHeight; ++level) {
-            predecessors[level]->next[level] = current->next[level];
+            link(predecessors[level], level, successor(current, level));
         }
-        delete current;
+        m_domain.retire(current, &reclaimNode, this);
 
         // minimize the height (max. height of all nodes between head and
         // sentinel)
-        for (std::uint16_t level = m_height; level >= 1; --level) {
-            if (m_head->next[level] != m_sentinel) {
+        for (std::uint16_t level = loadShared(m_height); level >= 1; --level) {
+            if (successor(m_head, level) != m_sentinel) {
                 // no direct connection between head and sentinel -> there is a
                 // node with height = level between
-                m_height = level;
+                storeShared(m_height, level);
                 break;
             }
         }
 
-        --m_size;
+        storeShared<size_type>(m_size, loadShared(m_size) - 1);
 
         checkConsistency();
 
@@ -162,82 +471,244 @@ class SequentialSkipList final : public SkipList<T>
         return true;
     }
 
-    bool contains(const_reference value) override
+    /**
+     * Destroys all nodes between head and sentinel, without relinking head.
+     */
+    void destroyNodes()
     {
-#ifdef COLLECT_STATISTICS
-        SkipListStatistics::threadLocalInstance().lookupStart();
-#endif
+        destroyNodes(
+            std::integral_constant<bool, ReleasesAllNodesAtOnce>());
+    }
 
-        auto* current = m_head;
-        for (std::int32_t level = m_height; level >= 0; --level) {
-            while (current->next[level]->value < value) {
-                current = current->next[level];
-            }
+    void destroyNodes(std::true_type)
+    {
+        m_allocator.releaseAll();
+        Storage::releaseAll(m_keyArena);
+    }
+
+    void destroyNodes(std::false_type)
+    {
+        for (auto* current = successor(m_head, 0); current != m_sentinel;) {
+            auto* next = successor(current, 0);
+            destroyNode(current);
+            current = next;
         }
-        current = current->next[0];
+    }
 
-#ifdef COLLECT_STATISTICS
-        SkipListStatistics::threadLocalInstance().lookupDone();
-#endif
+    static void reclaimNode(void* list, void* node)
+    {
+        static_cast<SequentialSkipList*>(list)->destroyNode(
+            static_cast<Node*>(node));
+    }
 
-        return current->value == value;
+    void destroyNode(Node* node)
+    {
+        Storage::release(m_keyArena, node->value);
+        destroyTowerNode(m_allocator, node);
     }
 
-    void clear() override
+    static Node* successor(const Node* node, std::uint16_t level)
     {
-        // remove all nodes between head and sentinel
-        for (auto* current = m_head->next[0]; current != m_sentinel;) {
-            auto* next = current->next[0];
-            delete current;
-            current = next;
+        return loadShared(node->next[level]);
+    }
+
+    /**
+     * Sets the successor of `node` on `level`, a release store if readers
+     * access the list concurrently.
+     */
+    static void link(Node* node, std::uint16_t level, Node* succ)
+    {
+        storeLink(node->next[level], succ);
+    }
+
+    template <typename Pointer>
+    static void storeLink(Pointer& link, Node* succ)
+    {
+        storeShared(link, succ);
+    }
+
+    static void storeLink(SuccessorKeyLink<Node, T>& link, Node* succ)
+    {
+        // the successor of the sentinel is nullptr
+        link.set(succ, succ != nullptr ? succ->value : value_type());
+    }
+
+    /**
+     * Fills an uninitialized link with coffee (see Node ctor), without
+     * reading the node it points to.
+     */
+    template <typename Pointer>
+    static void poison(Pointer& link)
+    {
+        link = reinterpret_cast<Node*>(0xC0FFEE);
+    }
+
+    static void poison(SuccessorKeyLink<Node, T>& link)
+    {
+        link.set(reinterpret_cast<Node*>(0xC0FFEE), value_type());
+    }
+
+    /**
+     * @return true if `node` precedes `value`, the sentinel succeeds all
+     * values
+     */
+    bool isBefore(const Node* node, const_reference value) const
+    {
+        return node != m_sentinel && m_compare(node->value, value);
+    }
+
+    /**
+     * @return true if `node`, which must not precede `value`, holds `value`
+     */
+    bool holds(const Node* node, const_reference value) const
+    {
+        return node != m_sentinel && !m_compare(value, node->value);
+    }
+
+    /**
+     * @return true if the node behind `link` (a loaded link) precedes
+     * `value`, compared by the cached value if the link holds one
+     */
+    bool precedes(const Node* link, const_reference value) const
+    {
+        return isBefore(link, value);
+    }
+
+    bool precedes(const SuccessorKeyLink<Node, T>& link,
+                  const_reference value) const
+    {
+        return link.node() != m_sentinel && m_compare(link.key(), value);
+    }
+
+    /**
+     * Search of `containsMany`, see interleavedSearch.
+     */
+    class InterleavedLookup
+    {
+      public:
+        using key_type = value_type;
+        using Node = typename SequentialSkipList::Node;
+
+        explicit InterleavedLookup(const SequentialSkipList& list)
+            : m_list(list)
+        {
         }
 
-        // set all changed next pointers of head node back to sentinel node
-        for (std::uint16_t level = 0; level <= m_height; ++level) {
-            m_head->next[level] = m_sentinel;
+        Node* head() const
+        {
+            return m_list.m_head;
         }
 
-        m_size = 0;
-        m_height = 0;
+        std::int32_t topLevel() const
+        {
+            return loadShared(m_list.m_height);
+        }
 
-        checkConsistency();
+        Node* next(const Node* node, std::int32_t level) const
+        {
+            return successor(node, level);
+        }
+
+        bool isRemoved(const Node*, std::int32_t) const
+        {
+            return false;
+        }
+
+        bool isBefore(const Node* node, const_reference value) const
+        {
+            return m_list.isBefore(node, value);
+        }
+
+        bool found(const Node* node, const_reference value) const
+        {
+            return m_list.holds(node, value);
+        }
+
+      private:
+        const SequentialSkipList& m_list;
+    };
+
+    /**
+     * @return First node which doesn't precede `value`
+     */
+    Node* lowerBound(const_reference value) const
+    {
+        Node* current = m_head;
+        for (std::int32_t level = loadShared(m_height); level >= 0; --level) {
+            auto next = loadShared(current->next[level]);
+            while (precedes(next, value)) {
+                current = next;
+                next = loadShared(current->next[level]);
+            }
+        }
+        return successor(current, 0);
     }
 
-  private:
     Node* searchNodeAndRememberPredecessors(
         const_reference value,
         std::array<Node*, MaximumHeight>& predecessors) const
     {
-        auto* current = m_head;
-        for (std::int32_t level = m_height; level >= 0; --level) {
-            while (current->next[level]->value < value) {
-                current = current->next[level];
+        Node* current = m_head;
+        for (std::int32_t level = loadShared(m_height); level >= 0; --level) {
+            auto next = loadShared(current->next[level]);
+            while (precedes(next, value)) {
+                current = next;
+                next = loadShared(current->next[level]);
             }
             predecessors[level] = current;
         }
-        return current->next[0];
+        return successor(current, 0);
     }
 
     /**
-     * @return Random height in range [0..MaximumHeight[
+     * Like `searchNodeAndRememberPredecessors`, but continues from the search
+     * path of a preceding value (finger search). The path stays valid on all
+     * levels on which `value` lies between the predecessor and its successor,
+     * which holds for all levels above the lowest one on which it does. The
+     * search climbs up to that level and descends from there, starting each
+     * level below at the node of the path if it is closer to `value`.
      */
-    static std::uint16_t randomHeight()
+    Node* searchFromPredecessors(
+        const_reference value,
+        std::array<Node*, MaximumHeight>& predecessors) const
     {
-        std::random_device randomDevice;
-        static thread_local std::mt19937 generator(randomDevice());
-        std::bernoulli_distribution distribution(0.5);
-        const auto flipCoinAndCheckIfHead = [&] {
-            return distribution(generator) == true;
-        };
+        const std::int32_t height = loadShared(m_height);
+        std::int32_t level = 0;
+        while (level <= height &&
+               !brackets(predecessors[level], level, value)) {
+            ++level;
+        }
+        if (level == 0) {
+            return successor(predecessors[0], 0);
+        }
 
-        std::uint16_t height = 0;
-        while (not flipCoinAndCheckIfHead() and
-               (height < (MaximumHeight - 1))) {
-            ++height;
+        auto* current = level > height ? m_head : predecessors[level];
+        for (--level; level >= 0; --level) {
+            auto* previous = predecessors[level];
+            if (previous != m_head && isBefore(previous, value) &&
+                (current == m_head ||
+                 m_compare(current->value, previous->value))) {
+                current = previous;
+            }
+            auto next = loadShared(current->next[level]);
+            while (precedes(next, value)) {
+                current = next;
+                next = loadShared(current->next[level]);
+            }
+            predecessors[level] = current;
         }
+        return successor(current, 0);
+    }
 
-        assert(height < MaximumHeight);
-        return height;
+    /**
+     * @return true if `value` lies between `pred` and its successor on
+     * `level`, i.e. if `pred` is its predecessor on that level
+     */
+    bool brackets(const Node* pred, std::uint16_t level,
+                  const_reference value) const
+    {
+        return (pred == m_head || isBefore(pred, value)) &&
+               !precedes(loadShared(pred->next[level]), value);
     }
 
     void checkConsistency() const
@@ -250,25 +721,19 @@ class SequentialSkipList final : public SkipList<T>
 
         // check all non-sentinel nodes
         for (auto* current = m_head; current != m_sentinel;
-             current = current->next[0]) {
+             current = successor(current, 0)) {
             const auto nodeHeight = current->height;
 
-            // non-coffee pointers up to node.height
+            // non-coffee pointers up to node.height, the tower ends there
             for (std::int16_t level = 1; level <= nodeHeight; level++) {
-                assert(current->next[level] != nullptr);
-                assert(current->next[level] != coffee);
-            }
-
-            // only coffee pointers above node.height
-            for (std::int16_t level = nodeHeight + 1; level < MaximumHeight;
-                 level++) {
-                assert(current->next[level] == coffee);
+                assert(successor(current, level) != nullptr);
+                assert(successor(current, level) != coffee);
             }
         }
 
         // sentinel node should only contain nullptrs
         for (std::int16_t level = 0; level < MaximumHeight; level++) {
-            assert(m_sentinel->next[level] == nullptr);
+            assert(successor(m_sentinel, level) == nullptr);
         }
 #endif
     }
@@ -276,6 +741,11 @@ class SequentialSkipList final : public SkipList<T>
   private:
     Node* const m_head;
     Node* const m_sentinel;
-    std::uint16_t m_height;
-    std::size_t m_size;
+    std::array<Node*, MaximumHeight> m_finger; // used if Finger::Enabled
+    typename Access::template Shared<std::uint16_t> m_height;
+    typename Access::template Shared<std::size_t> m_size;
+    Compare m_compare;
+    typename Storage::Arena m_keyArena;
+    Allocator m_allocator;
+    typename Access::Domain m_domain; // frees into m_keyArena, m_allocator
 };
@@ -0,0 +1,27 @@
+#include "ShardedCounter.h"
+
+#include <algorithm>
+
+const std::int64_t ShardedCounter::EstimateBatchSize;
+
+ShardedCounter::ShardedCounter()
+    : m_estimate(0)
+{
+}
+
+std::size_t ShardedCounter::value() const
+{
+    std::int64_t sum = 0;
+    m_stripes.forEach([&sum](const Stripe& stripe) {
+        sum += stripe.value.load(std::memory_order_acquire);
+    });
+
+    // a concurrent decrement may be seen without its matching increment
+    return static_cast<std::size_t>(std::max<std::int64_t>(sum, 0));
+}
+
+std::size_t ShardedCounter::estimate() const
+{
+    const auto estimate = m_estimate.load(std::memory_order_relaxed);
+    return static_cast<std::size_t>(std::max<std::int64_t>(estimate, 0));
+}
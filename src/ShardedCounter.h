@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "PerThread.h"
+
+/**
+ * Counter which is striped across the updating threads.
+ *
+ * Every thread only writes its own, cache-line padded stripe, so concurrent
+ * updates don't contend on a single cache line. The exact value is the sum of
+ * all stripes. Additionally each thread forwards its changes in batches to a
+ * shared estimate, which can be read in O(1) but may lag behind by up to
+ * `EstimateBatchSize` per thread.
+ */
+class ShardedCounter
+{
+  public:
+    static const std::int64_t EstimateBatchSize = 64;
+
+  private:
+    struct Stripe {
+        Stripe()
+            : value(0)
+            , published(0)
+        {
+        }
+
+        char padding[64]; /**< no false sharing with other stripes */
+        std::atomic<std::int64_t> value; /**< only written by its owner */
+        std::int64_t published; /**< part of value in the estimate */
+    };
+
+  public:
+    ShardedCounter();
+
+    ShardedCounter(const ShardedCounter&) = delete;
+    ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+    ShardedCounter& operator++()
+    {
+        add(1);
+        return *this;
+    }
+
+    ShardedCounter& operator--()
+    {
+        add(-1);
+        return *this;
+    }
+
+    void add(std::int64_t delta)
+    {
+        auto& stripe = m_stripes.local();
+        // no read-modify-write required, the stripe has a single writer
+        const auto value =
+            stripe.value.load(std::memory_order_relaxed) + delta;
+        stripe.value.store(value, std::memory_order_release);
+
+        const auto unpublished = value - stripe.published;
+        if (unpublished >= EstimateBatchSize ||
+            unpublished <= -EstimateBatchSize) {
+            m_estimate.fetch_add(unpublished, std::memory_order_relaxed);
+            stripe.published = value;
+        }
+    }
+
+    /**
+     * @return Sum of all stripes, exact if there are no concurrent updates
+     */
+    std::size_t value() const;
+
+    /**
+     * @return Approximation of `value()`, off by at most `EstimateBatchSize`
+     * per updating thread
+     */
+    std::size_t estimate() const;
+
+  private:
+    PerThread<Stripe> m_stripes;
+    std::atomic<std::int64_t> m_estimate;
+};
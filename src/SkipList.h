@@ -1,14 +1,12 @@
 #pragma once
 
 #include <cstdint>
-#include <type_traits>
+#include <functional>
 
 template <typename T>
 class SkipList
 {
   public:
-    static_assert(std::is_integral<T>::value, "T must be an integral type");
-
     using value_type = T;
     using reference = value_type&;
     using const_reference = const value_type&;
@@ -24,11 +22,114 @@ class SkipList
 
     virtual size_type size() = 0;
 
+    /**
+     * @return Approximate number of elements, cheaper than `size()` for
+     * concurrent implementations
+     */
+    virtual size_type sizeEstimate()
+    {
+        return size();
+    }
+
     virtual bool insert(const_reference value) = 0;
 
     virtual bool remove(const_reference value) = 0;
 
     virtual bool contains(const_reference value) = 0;
 
+    /**
+     * Batched `insert` of the sorted range [first, last), `results[i]`
+     * receives the result of `first[i]`. The lists continue the search of a
+     * value from the search path of the preceding one instead of starting at
+     * the head again.
+     * @return Number of inserted values
+     */
+    virtual size_type insertBatch(const_pointer first, const_pointer last,
+                                  bool* results)
+    {
+        size_type count = 0;
+        for (; first != last; ++first, ++results) {
+            *results = insert(*first);
+            count += *results ? 1 : 0;
+        }
+        return count;
+    }
+
+    /**
+     * Batched `remove`, see `insertBatch`.
+     * @return Number of removed values
+     */
+    virtual size_type removeBatch(const_pointer first, const_pointer last,
+                                  bool* results)
+    {
+        size_type count = 0;
+        for (; first != last; ++first, ++results) {
+            *results = remove(*first);
+            count += *results ? 1 : 0;
+        }
+        return count;
+    }
+
+    /**
+     * Batched `contains`, see `insertBatch`.
+     * @return Number of contained values
+     */
+    virtual size_type containsBatch(const_pointer first, const_pointer last,
+                                    bool* results)
+    {
+        size_type count = 0;
+        for (; first != last; ++first, ++results) {
+            *results = contains(*first);
+            count += *results ? 1 : 0;
+        }
+        return count;
+    }
+
+    /**
+     * `contains` of the values [first, last) in any order, `results[i]`
+     * receives the result of `first[i]`. The lists interleave the searches
+     * of several values, each one prefetches the node it compares next and
+     * yields to the others meanwhile, which overlaps their cache misses. By
+     * default the values are looked up one by one.
+     * @return Number of contained values
+     */
+    virtual size_type containsMany(const_pointer first, const_pointer last,
+                                   bool* results)
+    {
+        size_type count = 0;
+        for (; first != last; ++first, ++results) {
+            *results = contains(*first);
+            count += *results ? 1 : 0;
+        }
+        return count;
+    }
+
+    /**
+     * Inserts the values of the sorted range [first, last), equal values are
+     * inserted once. The lists build their towers bottom-up in linear time
+     * if they are empty, otherwise (and by default) the values are inserted
+     * one by one. Must not run concurrently with other operations.
+     * @return Number of inserted values
+     */
+    virtual size_type bulkLoad(const_pointer first, const_pointer last)
+    {
+        size_type count = 0;
+        for (; first != last; ++first) {
+            count += insert(*first) ? 1 : 0;
+        }
+        return count;
+    }
+
+    /**
+     * Calls `callback` for every value in [lo, hi) in ascending order. The
+     * concurrent lists are weakly consistent: values which are inserted or
+     * removed during the scan might or might not be visited, but no value is
+     * visited twice.
+     * @return Number of visited values
+     */
+    virtual size_type
+    rangeScan(const_reference lo, const_reference hi,
+              const std::function<void(const_reference)>& callback) = 0;
+
     virtual void clear() = 0;
 };
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include "SkipList.h"
+
+/**
+ * The concurrent skip lists are split into an engine, which implements the
+ * synchronization and stores an optional mapped value per key, and thin
+ * front-ends: `EngineSkipList` (the `SkipList<T>` set interface) and
+ * `ConcurrentSkipListMap`.
+ *
+ * An engine provides:
+ *
+ *  - `key_type`, `mapped_type`, `size_type`
+ *  - `bool insert(key, makeMapped, visitExisting)`: inserts `key` with the
+ *    value returned by `makeMapped()`, or calls
+ *    `visitExisting(std::atomic<mapped_type>&)` if the key is present.
+ *    Returns true if the key has been inserted. `makeMapped` may be called
+ *    even if the key turns out to be present.
+ *  - `bool remove(key)`
+ *  - `bool visit(key, visit)`: calls `visit(std::atomic<mapped_type>&)` if
+ *    the key is present and returns whether it was
+ *  - `insertBatch(first, last, makeMapped, visitExisting, results)`,
+ *    `removeBatch(first, last, results)` and
+ *    `visitBatch(first, last, visit, results)`: the operations above for a
+ *    sorted array of keys, see SkipList::insertBatch
+ *  - `visitMany(first, last, visit, results)`: `visitBatch` for keys in any
+ *    order, see SkipList::containsMany
+ *  - `size_type bulkLoad(first, last, getKey, getMapped)`: inserts a sorted
+ *    range, see SkipList::bulkLoad
+ *  - `size_type rangeScan(lo, hi, visit)`: calls
+ *    `visit(const key_type&, std::atomic<mapped_type>&)` for every key in
+ *    [lo, hi) in ascending order and returns the number of visited keys
+ *  - optionally `size_type snapshotScan(lo, hi, visit)`, a `rangeScan` which
+ *    is linearizable
+ *  - `begin()`, `end()`, `lower_bound(key)` and `upper_bound(key)`, which
+ *    return a `const_iterator` (see EngineIterator)
+ *  - `empty()`, `size()`, `sizeEstimate()` and `clear()`
+ *  - optionally `std::uint16_t topLevel()`, the level where the searches
+ *    start (see TopLevelHint)
+ *
+ * The visitors are called while the node is protected from reclamation, they
+ * must not keep a reference to the value after they returned.
+ *
+ * Scans and iterators are weakly consistent: they walk the bottom level and
+ * skip nodes which are not completely inserted or already removed. Keys which
+ * are inserted or removed concurrently might or might not be visited, but
+ * every key is visited at most once and in ascending order.
+ */
+
+/**
+ * Mapped type of engines which are used as a set.
+ */
+struct NoMapped {
+};
+
+/**
+ * `makeMapped` callback which returns a fixed value.
+ */
+template <typename Mapped>
+class ConstantMapped
+{
+  public:
+    explicit ConstantMapped(const Mapped& value)
+        : m_value(value)
+    {
+    }
+
+    Mapped operator()() const
+    {
+        return m_value;
+    }
+
+  private:
+    const Mapped& m_value;
+};
+
+/**
+ * Visitor which doesn't touch the mapped value.
+ */
+struct IgnoreMapped {
+    template <typename AtomicMapped>
+    void operator()(AtomicMapped&) const
+    {
+    }
+};
+
+/**
+ * Weakly consistent forward iterator over the keys of an engine.
+ *
+ * An iterator keeps a reclamation guard until it reaches the end, so the
+ * nodes it can reach are not freed. It must therefore be used and destroyed
+ * by the thread which created it and should not be kept longer than needed,
+ * as it delays the reclamation of all removed nodes. Engines only provide
+ * iterators for reclamation policies whose guards protect everything
+ * reachable (no hazard pointers).
+ *
+ * The engine provides `Guard`, `createGuard()`, `nextNode(node)` (the next
+ * live node) and `m_sentinel`.
+ */
+template <typename Engine, typename Node>
+class EngineIterator
+{
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename Engine::key_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+    using mapped_type = typename Engine::mapped_type;
+
+  public:
+    EngineIterator()
+        : m_engine(nullptr)
+        , m_node(nullptr)
+        , m_guard()
+    {
+    }
+
+    EngineIterator(const EngineIterator& other)
+        : m_engine(other.m_engine)
+        , m_node(other.m_node)
+        , m_guard(other.m_guard ? other.m_engine->createGuard() : nullptr)
+    {
+    }
+
+    EngineIterator(EngineIterator&& other) = default;
+
+    EngineIterator& operator=(const EngineIterator& other)
+    {
+        if (this != &other) {
+            *this = EngineIterator(other);
+        }
+        return *this;
+    }
+
+    EngineIterator& operator=(EngineIterator&& other) = default;
+
+    reference operator*() const
+    {
+        return m_node->key;
+    }
+
+    pointer operator->() const
+    {
+        return &m_node->key;
+    }
+
+    /**
+     * @return Value of the current key, which might be updated concurrently
+     */
+    std::atomic<mapped_type>& mapped() const
+    {
+        return m_node->mapped;
+    }
+
+    EngineIterator& operator++()
+    {
+        m_node = m_engine->nextNode(m_node);
+        if (m_node == m_engine->m_sentinel) {
+            m_guard.reset(); // nothing to protect anymore
+        }
+        return *this;
+    }
+
+    EngineIterator operator++(int)
+    {
+        EngineIterator previous(*this);
+        ++*this;
+        return previous;
+    }
+
+    friend bool operator==(const EngineIterator& lhs, const EngineIterator& rhs)
+    {
+        return lhs.m_node == rhs.m_node;
+    }
+
+    friend bool operator!=(const EngineIterator& lhs, const EngineIterator& rhs)
+    {
+        return lhs.m_node != rhs.m_node;
+    }
+
+  private:
+    friend Engine;
+
+    using Guard = typename Engine::Guard;
+
+    EngineIterator(Engine* engine, Node* node, std::unique_ptr<Guard> guard)
+        : m_engine(engine)
+        , m_node(node)
+        , m_guard(node != engine->m_sentinel ? std::move(guard) : nullptr)
+    {
+    }
+
+  private:
+    Engine* m_engine;
+    Node* m_node;
+    std::unique_ptr<Guard> m_guard;
+};
+
+/**
+ * `SkipList<T>` interface on top of an engine with `NoMapped` values.
+ */
+template <typename Engine>
+class EngineSkipList final : public SkipList<typename Engine::key_type>
+{
+  private:
+    using Base = SkipList<typename Engine::key_type>;
+
+  public:
+    using value_type = typename Base::value_type;
+    using reference = typename Base::reference;
+    using const_reference = typename Base::const_reference;
+    using pointer = typename Base::pointer;
+    using const_pointer = typename Base::const_pointer;
+    using difference_type = typename Base::difference_type;
+    using size_type = typename Base::size_type;
+    using const_iterator = typename Engine::const_iterator;
+    using iterator = const_iterator;
+
+  public:
+    bool empty() override
+    {
+        return m_engine.empty();
+    }
+
+    size_type size() override
+    {
+        return m_engine.size();
+    }
+
+    size_type sizeEstimate() override
+    {
+        return m_engine.sizeEstimate();
+    }
+
+    bool insert(const_reference value) override
+    {
+        const NoMapped mapped;
+        return m_engine.insert(value, ConstantMapped<NoMapped>(mapped),
+                               IgnoreMapped());
+    }
+
+    bool remove(const_reference value) override
+    {
+        return m_engine.remove(value);
+    }
+
+    bool contains(const_reference value) override
+    {
+        return m_engine.visit(value, IgnoreMapped());
+    }
+
+    size_type insertBatch(const_pointer first, const_pointer last,
+                          bool* results) override
+    {
+        const NoMapped mapped;
+        return m_engine.insertBatch(first, last,
+                                    ConstantMapped<NoMapped>(mapped),
+                                    IgnoreMapped(), results);
+    }
+
+    size_type removeBatch(const_pointer first, const_pointer last,
+                          bool* results) override
+    {
+        return m_engine.removeBatch(first, last, results);
+    }
+
+    size_type containsBatch(const_pointer first, const_pointer last,
+                            bool* results) override
+    {
+        return m_engine.visitBatch(first, last, IgnoreMapped(), results);
+    }
+
+    size_type containsMany(const_pointer first, const_pointer last,
+                           bool* results) override
+    {
+        return m_engine.visitMany(first, last, IgnoreMapped(), results);
+    }
+
+    size_type bulkLoad(const_pointer first, const_pointer last) override
+    {
+        return m_engine.bulkLoad(
+            first, last,
+            [](const_reference value) -> const_reference { return value; },
+            [](const_reference) { return NoMapped(); });
+    }
+
+    size_type
+    rangeScan(const_reference lo, const_reference hi,
+              const std::function<void(const_reference)>& callback) override
+    {
+        return m_engine.rangeScan(
+            lo, hi,
+            [&callback](const_reference value, std::atomic<NoMapped>&) {
+                callback(value);
+            });
+    }
+
+    /**
+     * Linearizable `rangeScan`, only available if the engine supports it.
+     */
+    size_type
+    snapshotScan(const_reference lo, const_reference hi,
+                 const std::function<void(const_reference)>& callback)
+    {
+        return m_engine.snapshotScan(
+            lo, hi,
+            [&callback](const_reference value, std::atomic<NoMapped>&) {
+                callback(value);
+            });
+    }
+
+    /**
+     * Level where the searches start, only available if the engine has one.
+     */
+    std::uint16_t topLevel() const
+    {
+        return m_engine.topLevel();
+    }
+
+    void clear() override
+    {
+        m_engine.clear();
+    }
+
+    const_iterator begin()
+    {
+        return m_engine.begin();
+    }
+
+    const_iterator end()
+    {
+        return m_engine.end();
+    }
+
+    /**
+     * @return Iterator to the first value which is not less than `value`
+     */
+    const_iterator lower_bound(const_reference value)
+    {
+        return m_engine.lower_bound(value);
+    }
+
+    /**
+     * @return Iterator to the first value which is greater than `value`
+     */
+    const_iterator upper_bound(const_reference value)
+    {
+        return m_engine.upper_bound(value);
+    }
+
+  private:
+    Engine m_engine;
+};
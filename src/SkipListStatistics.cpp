@@ -24,6 +24,11 @@ void SkipListStatistics::reset()
     m_numberOfLookups = 0;
     m_numberOfLookupRetries = 0;
     m_maxRetriesDuringLookup = 0;
+
+    m_numberOfReclaimedNodes = 0;
+    m_reclaimedMemory = 0;
+
+    m_numberOfLockAcquisitions = 0;
 }
 
 void SkipListStatistics::insertionStart()
@@ -96,6 +101,17 @@ void SkipListStatistics::lookupDone()
         std::max(m_maxRetriesDuringLookup, m_lookupRetryCounter);
 }
 
+void SkipListStatistics::nodeReclaimed(std::size_t bytes)
+{
+    ++m_numberOfReclaimedNodes;
+    m_reclaimedMemory += bytes;
+}
+
+void SkipListStatistics::lockAcquired()
+{
+    ++m_numberOfLockAcquisitions;
+}
+
 void SkipListStatistics::mergeInto(SkipListStatistics& other) const
 {
     other.m_numberOfInsertions += m_numberOfInsertions;
@@ -116,6 +132,11 @@ void SkipListStatistics::mergeInto(SkipListStatistics& other) const
     other.m_numberOfLookupRetries += m_numberOfLookupRetries;
     other.m_maxRetriesDuringLookup =
         std::max(m_maxRetriesDuringLookup, other.m_maxRetriesDuringLookup);
+
+    other.m_numberOfReclaimedNodes += m_numberOfReclaimedNodes;
+    other.m_reclaimedMemory += m_reclaimedMemory;
+
+    other.m_numberOfLockAcquisitions += m_numberOfLockAcquisitions;
 }
 
 SkipListStatistics& SkipListStatistics::threadLocalInstance()
@@ -199,3 +220,18 @@ std::size_t SkipListStatistics::maximumNumberOfRetriesDuringLookup() const
 {
     return m_maxRetriesDuringLookup;
 }
+
+std::size_t SkipListStatistics::numberOfReclaimedNodes() const
+{
+    return m_numberOfReclaimedNodes;
+}
+
+std::size_t SkipListStatistics::reclaimedMemory() const
+{
+    return m_reclaimedMemory;
+}
+
+std::size_t SkipListStatistics::numberOfLockAcquisitions() const
+{
+    return m_numberOfLockAcquisitions;
+}
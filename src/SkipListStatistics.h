@@ -23,6 +23,10 @@ class SkipListStatistics
     void lookupRetry();
     void lookupDone();
 
+    void nodeReclaimed(std::size_t bytes);
+
+    void lockAcquired();
+
     void mergeInto(SkipListStatistics& other) const;
 
     static SkipListStatistics& threadLocalInstance();
@@ -41,6 +45,11 @@ class SkipListStatistics
     double averageNumberOfRetriesDuringLookup() const;
     std::size_t maximumNumberOfRetriesDuringLookup() const;
 
+    std::size_t numberOfReclaimedNodes() const;
+    std::size_t reclaimedMemory() const;
+
+    std::size_t numberOfLockAcquisitions() const;
+
   private:
     std::size_t m_numberOfInsertions;
     std::size_t m_numberOfInsertionRetries;
@@ -60,4 +69,9 @@ class SkipListStatistics
     std::size_t m_numberOfLookupRetries;
     std::size_t m_maxRetriesDuringLookup;
     std::size_t m_lookupRetryCounter; // to determine the max. no. retries
+
+    std::size_t m_numberOfReclaimedNodes;
+    std::size_t m_reclaimedMemory; // in bytes
+
+    std::size_t m_numberOfLockAcquisitions;
 };
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "PerThread.h"
+
+/**
+ * Version labels of a node of a list with snapshot support. A label is 0
+ * until it has been assigned.
+ */
+template <typename Node>
+struct SnapshotLabels {
+    std::atomic<std::uint64_t> insertTime{0};
+    std::atomic<std::uint64_t> deleteTime{0};
+
+    // link of the removal log the node has been added to
+    std::atomic<bool> logged{false};
+    std::atomic<Node*> logNext{nullptr};
+};
+
+/**
+ * Linearizable snapshots of a lock-free list without blocking writers
+ * (following Arbel-Raviv & Brown, 2018).
+ *
+ * Every insertion and removal is labeled with the value of a global version
+ * clock right after it took effect (threads which observe an unlabeled node
+ * help to label it). A snapshot increments the clock and sees exactly the
+ * nodes with `insertTime <= version < deleteTime`.
+ *
+ * A node removed after the snapshot has been taken might already be unlinked
+ * when the scan passes its position. Therefore the thread which unlinks a
+ * node from the bottom level first adds it to its removal log, and scans
+ * visit the logs of all threads in addition to the list. The log holds a
+ * reference to the node (see `References`) and drops it once no announced
+ * snapshot can still see the node, so the reclamation of removed nodes is
+ * delayed by running snapshots only.
+ *
+ * Requires a reclamation policy whose guards protect everything reachable
+ * (epoch-based or none), the logs are traversed without hazard pointers.
+ */
+template <typename Node>
+class SnapshotDomain
+{
+  private:
+    struct Record {
+        std::atomic<Node*> head{nullptr};
+
+        // lower bound of the version of the running snapshot, 0 if none
+        std::atomic<std::uint64_t> announcement{0};
+
+        // only accessed by the owning thread
+        std::size_t nestingDepth = 0;
+        std::size_t numberOfLoggedNodes = 0;
+    };
+
+    // every n-th logged node trims the log of the calling thread
+    static const std::size_t TrimInterval = 64;
+
+  public:
+    SnapshotDomain()
+        : m_clock(1)
+        , m_records()
+    {
+    }
+
+    SnapshotDomain(const SnapshotDomain&) = delete;
+    SnapshotDomain& operator=(const SnapshotDomain&) = delete;
+
+    /**
+     * Labels the insertion of a node which is linked on the bottom level.
+     */
+    void labelInsert(Node* node)
+    {
+        label(node->labels.insertTime);
+    }
+
+    /**
+     * Labels the removal of a node whose bottom level link is marked.
+     */
+    void labelDelete(Node* node)
+    {
+        labelInsert(node);
+        label(node->labels.deleteTime);
+    }
+
+    /**
+     * Must be called before the node is unlinked from the bottom level, keeps
+     * it visible to running snapshots.
+     * @param release Called for each node which is dropped from the log
+     */
+    template <typename Release>
+    void logRemoval(Node* node, Release release)
+    {
+        labelDelete(node);
+        if (node->labels.logged.exchange(true)) {
+            return; // logged by a concurrent unlinker
+        }
+
+        auto& record = m_records.local();
+        node->labels.logNext.store(record.head.load());
+        record.head.store(node);
+
+        if (++record.numberOfLoggedNodes % TrimInterval == 0) {
+            trim(record, release);
+        }
+    }
+
+    /**
+     * Announces a snapshot of the calling thread, must be paired with
+     * `endSnapshot`.
+     * @return Version of the snapshot
+     */
+    std::uint64_t beginSnapshot()
+    {
+        auto& record = m_records.local();
+        if (record.nestingDepth++ == 0) {
+            // the announcement must not be greater than the version, trimming
+            // threads only drop nodes removed before all announcements
+            record.announcement.store(m_clock.load());
+        }
+        return m_clock.fetch_add(1);
+    }
+
+    void endSnapshot()
+    {
+        auto& record = m_records.local();
+        if (--record.nestingDepth == 0) {
+            record.announcement.store(0);
+        }
+    }
+
+    /**
+     * @param marked Whether the bottom level link of the node is marked, read
+     * before calling this function
+     * @return true if the node has been in the list at `version`
+     */
+    bool isVisible(Node* node, bool marked, std::uint64_t version)
+    {
+        // unlabeled operations took effect after the snapshot, help to label
+        // them so that the decision is final
+        labelInsert(node);
+        if (node->labels.insertTime.load() > version) {
+            return false;
+        }
+
+        if (marked) {
+            labelDelete(node);
+        }
+        const auto deleteTime = node->labels.deleteTime.load();
+        return deleteTime == 0 || deleteTime > version;
+    }
+
+    /**
+     * Calls `function(node)` for the logged nodes of all threads.
+     */
+    template <typename Function>
+    void forEachLoggedNode(Function function)
+    {
+        m_records.forEach([&function](Record& record) {
+            for (auto* node = record.head.load(); node != nullptr;
+                 node = node->labels.logNext.load()) {
+                function(node);
+            }
+        });
+    }
+
+    /**
+     * Calls `destroy(node)` for all logged nodes and empties the logs,
+     * requires that no other thread accesses the list anymore.
+     */
+    template <typename Destroy>
+    void drain(Destroy destroy)
+    {
+        m_records.forEach([&destroy](Record& record) {
+            for (auto* node = record.head.exchange(nullptr); node != nullptr;) {
+                auto* next = node->labels.logNext.load();
+                destroy(node);
+                node = next;
+            }
+        });
+    }
+
+  private:
+    void label(std::atomic<std::uint64_t>& time)
+    {
+        if (time.load() == 0) {
+            std::uint64_t unlabeled = 0;
+            time.compare_exchange_strong(unlabeled, m_clock.load());
+        }
+    }
+
+    /**
+     * Drops the nodes from the log of the calling thread which have been
+     * removed before all announced snapshots. Concurrent readers still see
+     * consistent links, the dropped nodes are protected by their guards.
+     */
+    template <typename Release>
+    void trim(Record& record, Release release)
+    {
+        // the clock is read before the announcements, snapshots announced
+        // afterwards have a version of at least `bound`
+        auto bound = m_clock.load();
+        m_records.forEach([&bound](Record& other) {
+            const auto announcement = other.announcement.load();
+            if (announcement != 0 && announcement < bound) {
+                bound = announcement;
+            }
+        });
+
+        Node* predecessor = nullptr;
+        for (auto* node = record.head.load(); node != nullptr;) {
+            auto* next = node->labels.logNext.load();
+            if (node->labels.deleteTime.load() < bound) {
+                if (predecessor == nullptr) {
+                    record.head.store(next);
+                } else {
+                    predecessor->labels.logNext.store(next);
+                }
+                release(node);
+            } else {
+                predecessor = node;
+            }
+            node = next;
+        }
+    }
+
+  private:
+    std::atomic<std::uint64_t> m_clock;
+    PerThread<Record> m_records;
+};
+
+/**
+ * Snapshot policy of LockFreeSkipListEngine without snapshot support, all
+ * labeling operations are no-ops.
+ */
+struct NoSnapshots {
+    static constexpr bool Enabled = false;
+
+    /**
+     * Number of node references held by the removal logs.
+     */
+    static constexpr std::uint8_t References = 0;
+
+    template <typename Node>
+    struct Labels {
+    };
+
+    template <typename Node>
+    class Domain
+    {
+      public:
+        void labelInsert(Node*)
+        {
+        }
+
+        void labelDelete(Node*)
+        {
+        }
+
+        template <typename Release>
+        void logRemoval(Node*, Release)
+        {
+        }
+
+        template <typename Destroy>
+        void drain(Destroy)
+        {
+        }
+    };
+};
+
+/**
+ * Snapshot policy of LockFreeSkipListEngine which enables `snapshotScan`, see
+ * SnapshotDomain.
+ */
+struct VersionedSnapshots {
+    static constexpr bool Enabled = true;
+    static constexpr std::uint8_t References = 1;
+
+    template <typename Node>
+    using Labels = SnapshotLabels<Node>;
+
+    template <typename Node>
+    using Domain = SnapshotDomain<Node>;
+};
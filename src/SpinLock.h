@@ -0,0 +1,486 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "PerThread.h"
+
+/**
+ * Hints the processor that the calling thread busy-waits.
+ */
+inline void spinPause()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ * Idle policy of BasicSpinBackoff which gives up the processor, so that a
+ * handover to the waiting thread stays as fast as the scheduler allows.
+ */
+struct YieldingIdle {
+    static void wait()
+    {
+        std::this_thread::yield();
+    }
+};
+
+/**
+ * Idle policy of BasicSpinBackoff for locks of which one is held per node,
+ * whose holders only do a few stores. Keeps spinning as long as spinning has
+ * recently paid off for the thread (adaptive spinning, like glibc's adaptive
+ * mutexes): up to twice the average number of rounds it took to get through,
+ * so a waiter whose holder runs on another core doesn't sleep for much longer
+ * than the lock is held. Sleeps once the rounds are used up, then the holder
+ * has most likely been preempted, and yielding would only let the waiting
+ * threads take turns if there are more threads than cores. A wait which ended
+ * in a sleep counts as zero rounds.
+ */
+class SleepingIdle
+{
+  public:
+    ~SleepingIdle()
+    {
+        // the thread has got through, e.g. it holds the lock now
+        auto& average = averageRounds();
+        const std::int32_t rounds = m_slept ? 0 : m_rounds;
+        average = (7 * average + rounds) / 8;
+    }
+
+    void wait()
+    {
+        if (!m_slept && m_rounds < MaximumRounds &&
+            m_rounds < 2 * averageRounds() + MinimumRounds) {
+            ++m_rounds;
+            for (std::uint32_t i = 0; i < PausesPerRound; ++i) {
+                spinPause();
+            }
+        } else {
+            m_slept = true;
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+  private:
+    static const std::int32_t MinimumRounds = 1;
+    static const std::int32_t MaximumRounds = 256;
+    static const std::uint32_t PausesPerRound = 64;
+
+    static std::int32_t& averageRounds()
+    {
+        static thread_local std::int32_t average = 0;
+        return average;
+    }
+
+    std::int32_t m_rounds = 0;
+    bool m_slept = false;
+};
+
+/**
+ * Waits with an exponentially growing number of pauses, and waits as told
+ * by `Idle` (YieldingIdle or SleepingIdle) once the waiting takes longer
+ * (e.g. if the lock holder has been preempted).
+ */
+template <typename Idle>
+class BasicSpinBackoff
+{
+  public:
+    void operator()()
+    {
+        if (m_pauses <= MaximumPauses) {
+            for (std::uint32_t i = 0; i < m_pauses; ++i) {
+                spinPause();
+            }
+            m_pauses *= 2;
+        } else {
+            m_idle.wait();
+        }
+    }
+
+  private:
+    static const std::uint32_t MaximumPauses = 64;
+
+    std::uint32_t m_pauses = 1;
+    Idle m_idle;
+};
+
+using SpinBackoff = BasicSpinBackoff<YieldingIdle>;
+using SleepingBackoff = BasicSpinBackoff<SleepingIdle>;
+
+/**
+ * Test-and-test-and-set spin lock of a single byte, small enough to be
+ * embedded into every node. Waiting threads spin on a plain load, so they
+ * only write the cache line when the lock has been released. Not recursive.
+ * Satisfies Lockable, i.e. can be used with std::lock_guard.
+ * @tparam Backoff SpinBackoff or SleepingBackoff
+ */
+template <typename Backoff>
+class BasicTTASLock
+{
+  public:
+    BasicTTASLock() = default;
+
+    BasicTTASLock(const BasicTTASLock&) = delete;
+    BasicTTASLock& operator=(const BasicTTASLock&) = delete;
+
+    void lock()
+    {
+        Backoff backoff;
+        while (m_locked.exchange(true, std::memory_order_acquire)) {
+            while (m_locked.load(std::memory_order_relaxed)) {
+                backoff();
+            }
+        }
+    }
+
+    bool try_lock()
+    {
+        return !m_locked.load(std::memory_order_relaxed) &&
+               !m_locked.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock()
+    {
+        m_locked.store(false, std::memory_order_release);
+    }
+
+  private:
+    std::atomic<bool> m_locked{false};
+};
+
+using TTASLock = BasicTTASLock<SpinBackoff>;
+
+/**
+ * Ticket lock: threads take a ticket and enter in the order of their tickets,
+ * i.e. first come first served. All waiting threads spin on the same counter,
+ * but back off in proportion to the number of threads ahead of them.
+ * Satisfies Lockable.
+ */
+class TicketLock
+{
+  public:
+    TicketLock() = default;
+
+    TicketLock(const TicketLock&) = delete;
+    TicketLock& operator=(const TicketLock&) = delete;
+
+    void lock()
+    {
+        const auto ticket = m_next.fetch_add(1, std::memory_order_relaxed);
+        SpinBackoff backoff;
+        for (;;) {
+            const auto serving = m_serving.load(std::memory_order_acquire);
+            if (serving == ticket) {
+                return;
+            }
+            for (auto ahead = ticket - serving; ahead > 1; --ahead) {
+                spinPause();
+            }
+            backoff();
+        }
+    }
+
+    bool try_lock()
+    {
+        auto ticket = m_serving.load(std::memory_order_relaxed);
+        return m_next.compare_exchange_strong(ticket, ticket + 1,
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed);
+    }
+
+    void unlock()
+    {
+        m_serving.store(m_serving.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_release);
+    }
+
+  private:
+    std::atomic<std::uint32_t> m_next{0};
+    std::atomic<std::uint32_t> m_serving{0};
+};
+
+/**
+ * MCS queue lock (Mellor-Crummey and Scott, 1991): waiting threads form a
+ * queue and each one spins on a flag in its own queue node, which its
+ * predecessor clears on unlock. So a release invalidates a single cache line
+ * of a single waiting thread, and threads enter first come first served.
+ * The queue nodes are per thread and lock. Satisfies Lockable.
+ */
+class MCSLock
+{
+  private:
+    struct QueueNode {
+        std::atomic<QueueNode*> next{nullptr};
+        std::atomic<bool> waiting{false};
+    };
+
+  public:
+    MCSLock() = default;
+
+    MCSLock(const MCSLock&) = delete;
+    MCSLock& operator=(const MCSLock&) = delete;
+
+    void lock()
+    {
+        auto& node = m_nodes.local();
+        node.next.store(nullptr, std::memory_order_relaxed);
+        node.waiting.store(true, std::memory_order_relaxed);
+
+        auto* predecessor = m_tail.exchange(&node, std::memory_order_acq_rel);
+        if (predecessor != nullptr) {
+            predecessor->next.store(&node, std::memory_order_release);
+            SpinBackoff backoff;
+            while (node.waiting.load(std::memory_order_acquire)) {
+                backoff();
+            }
+        }
+    }
+
+    bool try_lock()
+    {
+        auto& node = m_nodes.local();
+        node.next.store(nullptr, std::memory_order_relaxed);
+
+        QueueNode* expected = nullptr;
+        return m_tail.compare_exchange_strong(expected, &node,
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed);
+    }
+
+    void unlock()
+    {
+        auto& node = m_nodes.local();
+        auto* successor = node.next.load(std::memory_order_acquire);
+        if (successor == nullptr) {
+            auto* expected = &node;
+            if (m_tail.compare_exchange_strong(expected, nullptr,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+                return;
+            }
+            // a successor has enqueued itself, but not yet linked its node
+            while ((successor = node.next.load(std::memory_order_acquire)) ==
+                   nullptr) {
+                spinPause();
+            }
+        }
+        successor->waiting.store(false, std::memory_order_release);
+    }
+
+  private:
+    std::atomic<QueueNode*> m_tail{nullptr};
+    PerThread<QueueNode> m_nodes;
+};
+
+/**
+ * CLH queue lock (Craig, Landin and Hagersten, 1993): each waiting thread
+ * spins on the queue node of its predecessor, which the predecessor clears on
+ * unlock. Unlike MCSLock an unlock never waits for a successor, but a thread
+ * gives its node to its successor and reuses the node of its predecessor
+ * instead. Satisfies BasicLockable only: a thread cannot leave the queue
+ * once it has enqueued its node, so there is no `try_lock`.
+ */
+class CLHLock
+{
+  private:
+    struct QueueNode {
+        std::atomic<bool> locked{false};
+    };
+
+    struct Record {
+        QueueNode* node = nullptr;
+        QueueNode* predecessor = nullptr;
+    };
+
+  public:
+    CLHLock()
+        : m_tail(new QueueNode())
+    {
+    }
+
+    ~CLHLock()
+    {
+        // every node is either owned by a thread or the tail
+        delete m_tail.load();
+        m_records.forEach([](Record& record) { delete record.node; });
+    }
+
+    CLHLock(const CLHLock&) = delete;
+    CLHLock& operator=(const CLHLock&) = delete;
+
+    void lock()
+    {
+        auto& record = this->record();
+        record.node->locked.store(true, std::memory_order_relaxed);
+        record.predecessor =
+            m_tail.exchange(record.node, std::memory_order_acq_rel);
+
+        SpinBackoff backoff;
+        while (record.predecessor->locked.load(std::memory_order_acquire)) {
+            backoff();
+        }
+    }
+
+    void unlock()
+    {
+        auto& record = this->record();
+        auto* node = record.node;
+        record.node = record.predecessor;
+        node->locked.store(false, std::memory_order_release);
+    }
+
+  private:
+    Record& record()
+    {
+        auto& record = m_records.local();
+        if (record.node == nullptr) {
+            record.node = new QueueNode();
+        }
+        return record;
+    }
+
+    std::atomic<QueueNode*> m_tail;
+    PerThread<Record> m_records;
+};
+
+/**
+ * Spin lock with a version number (OPTIK, Guerraoui and Trigonakis, 2016),
+ * which is odd while the lock is held and grows with every release. A
+ * thread which has read the version before it read the data protected by the
+ * lock, can later lock it only if the data has not been changed meanwhile
+ * (`tryLock(version)`), or check that without locking (`isVersion`).
+ * Satisfies Lockable, i.e. can be used with std::lock_guard.
+ * @tparam Backoff SpinBackoff or SleepingBackoff
+ */
+template <typename Backoff>
+class BasicVersionedLock
+{
+  public:
+    using Version = std::uint32_t;
+
+    BasicVersionedLock() = default;
+
+    BasicVersionedLock(const BasicVersionedLock&) = delete;
+    BasicVersionedLock& operator=(const BasicVersionedLock&) = delete;
+
+    /**
+     * @return Current version, must be read before the protected data
+     */
+    Version version() const
+    {
+        return m_version.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @return true if the lock is free and still has `version`
+     */
+    bool isVersion(Version version) const
+    {
+        return !isLocked(version) && this->version() == version;
+    }
+
+    /**
+     * Locks if the lock is free and still has `version`, fails immediately
+     * otherwise.
+     */
+    bool tryLock(Version version)
+    {
+        return !isLocked(version) &&
+               m_version.compare_exchange_strong(version, version + 1,
+                                                 std::memory_order_acquire,
+                                                 std::memory_order_relaxed);
+    }
+
+    void lock()
+    {
+        Backoff backoff;
+        while (!try_lock()) {
+            backoff();
+        }
+    }
+
+    bool try_lock()
+    {
+        return tryLock(m_version.load(std::memory_order_relaxed));
+    }
+
+    void unlock()
+    {
+        m_version.store(m_version.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_release);
+    }
+
+  private:
+    static bool isLocked(Version version)
+    {
+        return (version & 1) != 0;
+    }
+
+    std::atomic<Version> m_version{0};
+};
+
+using VersionedLock = BasicVersionedLock<SpinBackoff>;
+
+/**
+ * Validation policy of LazySkipList which locks the predecessors found by a
+ * search and validates afterwards that they still precede the successors,
+ * waiting for concurrent lock holders. The node locks sleep once a holder
+ * takes longer than spinning has recently taken, it is most likely
+ * preempted (see SleepingIdle).
+ */
+struct LockThenValidate {
+    static constexpr bool Optimistic = false;
+
+    using Lock = BasicTTASLock<SleepingBackoff>;
+    using Version = std::uint8_t;
+
+    static Version version(const Lock&)
+    {
+        return 0;
+    }
+
+    static bool isVersion(const Lock&, Version)
+    {
+        return true;
+    }
+
+    static bool lock(Lock& lock, Version)
+    {
+        lock.lock();
+        return true;
+    }
+};
+
+/**
+ * Validation policy of LazySkipList which records the versions of the
+ * predecessors during the search. An update validates them before it takes
+ * any lock and locks a predecessor only if its version is unchanged, so an
+ * update which conflicts with another one fails fast and retries instead of
+ * waiting for the other one's locks.
+ */
+struct OptimisticValidation {
+    static constexpr bool Optimistic = true;
+
+    using Lock = BasicVersionedLock<SleepingBackoff>;
+    using Version = Lock::Version;
+
+    static Version version(const Lock& lock)
+    {
+        return lock.version();
+    }
+
+    static bool isVersion(const Lock& lock, Version version)
+    {
+        return lock.isVersion(version);
+    }
+
+    static bool lock(Lock& lock, Version version)
+    {
+        return lock.tryLock(version);
+    }
+};
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "KeyStorage.h"
+#include "NodeAllocator.h"
+
+/**
+ * Variable-length key which doesn't own its characters.
+ *
+ * The first 8 bytes are kept inline as a big-endian integer, so that most
+ * comparisons during a search are decided by a single integer comparison
+ * without dereferencing the character pointer. Only keys with an equal prefix
+ * compare the remaining bytes.
+ *
+ * The lists copy the characters into their key arena on insertion (see
+ * `KeyStorage<StringKey>`), a key passed to `insert` may therefore refer to a
+ * temporary buffer.
+ */
+class StringKey
+{
+  public:
+    static constexpr std::size_t PrefixSize = sizeof(std::uint64_t);
+
+  public:
+    StringKey()
+        : m_prefix(0)
+        , m_data(nullptr)
+        , m_size(0)
+    {
+    }
+
+    StringKey(const char* data, std::size_t size)
+        : m_prefix(loadPrefix(data, size))
+        , m_data(data)
+        , m_size(static_cast<std::uint32_t>(size))
+    {
+    }
+
+    /**
+     * The key refers to the characters of `string`, which must outlive it.
+     */
+    explicit StringKey(const std::string& string)
+        : StringKey(string.data(), string.size())
+    {
+    }
+
+    const char* data() const
+    {
+        return m_data;
+    }
+
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    std::uint64_t prefix() const
+    {
+        return m_prefix;
+    }
+
+    std::string str() const
+    {
+        return std::string(m_data, m_size);
+    }
+
+    friend bool operator<(const StringKey& lhs, const StringKey& rhs)
+    {
+        if (lhs.m_prefix != rhs.m_prefix) {
+            return lhs.m_prefix < rhs.m_prefix;
+        }
+
+        // the prefixes are zero-padded, equal prefixes of short keys might
+        // still differ in their size
+        const auto minimumSize = lhs.m_size < rhs.m_size ? lhs.m_size
+                                                         : rhs.m_size;
+        if (minimumSize > PrefixSize) {
+            const auto result =
+                std::memcmp(lhs.m_data + PrefixSize, rhs.m_data + PrefixSize,
+                            minimumSize - PrefixSize);
+            if (result != 0) {
+                return result < 0;
+            }
+        }
+        return lhs.m_size < rhs.m_size;
+    }
+
+    friend bool operator==(const StringKey& lhs, const StringKey& rhs)
+    {
+        return lhs.m_prefix == rhs.m_prefix && lhs.m_size == rhs.m_size &&
+               (lhs.m_size <= PrefixSize ||
+                std::memcmp(lhs.m_data + PrefixSize, rhs.m_data + PrefixSize,
+                            lhs.m_size - PrefixSize) == 0);
+    }
+
+    friend bool operator!=(const StringKey& lhs, const StringKey& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+  private:
+    static std::uint64_t loadPrefix(const char* data, std::size_t size)
+    {
+        std::uint64_t prefix = 0;
+        for (std::size_t i = 0; i < PrefixSize; ++i) {
+            prefix <<= 8;
+            if (i < size) {
+                prefix |= static_cast<unsigned char>(data[i]);
+            }
+        }
+        return prefix;
+    }
+
+  private:
+    std::uint64_t m_prefix;
+    const char* m_data;
+    std::uint32_t m_size;
+};
+
+/**
+ * Copies the characters of the keys into a slab arena owned by the list, in
+ * size classes of 16 bytes.
+ */
+template <>
+struct KeyStorage<StringKey> {
+    using Arena = SlabNodeAllocator<false, StringKey>;
+
+    static constexpr std::size_t Granularity = 16;
+
+    static StringKey store(Arena& arena, const StringKey& key)
+    {
+        if (key.size() == 0) {
+            return StringKey();
+        }
+
+        assert(key.size() <= Arena::ChunkSize);
+        const auto sizeClass = (key.size() + Granularity - 1) / Granularity;
+        auto* data = static_cast<char*>(arena.allocate(
+            static_cast<std::uint16_t>(sizeClass), sizeClass * Granularity));
+        std::memcpy(data, key.data(), key.size());
+        return StringKey(data, key.size());
+    }
+
+    static void release(Arena& arena, const StringKey& key)
+    {
+        if (key.size() == 0) {
+            return;
+        }
+
+        const auto sizeClass = (key.size() + Granularity - 1) / Granularity;
+        arena.deallocate(const_cast<char*>(key.data()),
+                         static_cast<std::uint16_t>(sizeClass),
+                         sizeClass * Granularity);
+    }
+
+    static void releaseAll(Arena& arena)
+    {
+        arena.releaseAll();
+    }
+};
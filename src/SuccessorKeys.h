@@ -0,0 +1,73 @@
+#pragma once
+
+/**
+ * Tower slot which stores the key of the node it links to next to the
+ * pointer, so that a search decides whether to move right without loading
+ * the successor. Converts to the plain pointer.
+ */
+template <typename Node, typename Key>
+class SuccessorKeyLink
+{
+  public:
+    SuccessorKeyLink()
+        : m_node(nullptr)
+        , m_key()
+    {
+    }
+
+    /**
+     * Links `node`, which holds `key`.
+     */
+    void set(Node* node, const Key& key)
+    {
+        m_node = node;
+        m_key = key;
+    }
+
+    Node* node() const
+    {
+        return m_node;
+    }
+
+    /**
+     * @return Key of `node()`, undefined if it is nullptr or a sentinel
+     */
+    const Key& key() const
+    {
+        return m_key;
+    }
+
+    operator Node*() const
+    {
+        return m_node;
+    }
+
+  private:
+    Node* m_node;
+    Key m_key;
+};
+
+/**
+ * Link policy of SequentialSkipList and LazySkipList whose towers hold plain
+ * pointers, every step of a search loads the successor to compare its key.
+ */
+struct NoSuccessorKeys {
+    static constexpr bool Enabled = false;
+
+    template <typename Node, typename Key, typename Pointer>
+    using Link = Pointer;
+};
+
+/**
+ * Link policy whose towers hold SuccessorKeyLinks. A search only loads the
+ * successor when it moves right, the comparisons which make it descend are
+ * done on the node it is standing on. The keys are immutable once linked,
+ * so they are copied into the slot with the pointer, which doubles the tower
+ * for 8 byte keys; the keys must be trivially copyable.
+ */
+struct CachedSuccessorKeys {
+    static constexpr bool Enabled = true;
+
+    template <typename Node, typename Key, typename Pointer>
+    using Link = SuccessorKeyLink<Node, Key>;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Highest level of a concurrent list on which a node may be linked, where
+ * its searches start instead of the top level of the head, so that small
+ * lists don't walk the empty levels and the maximum height can be chosen for
+ * the largest lists.
+ *
+ * The hint only grows. An insert raises it to the height of its node before
+ * it searches the predecessors, so every thread which reaches the node
+ * afterwards through the links reads a hint at least as high. A search
+ * which started with an older hint may find a node below its top level;
+ * only levels up to the hint are searched and filled into the search path.
+ */
+class TopLevelHint
+{
+  public:
+    TopLevelHint()
+        : m_level(0)
+    {
+    }
+
+    std::uint16_t load() const
+    {
+        return m_level.load(std::memory_order_acquire);
+    }
+
+    void raise(std::uint16_t level)
+    {
+        auto current = load();
+        while (current < level &&
+               !m_level.compare_exchange_weak(current, level)) {
+        }
+    }
+
+  private:
+    std::atomic<std::uint16_t> m_level;
+};
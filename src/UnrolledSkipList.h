@@ -0,0 +1,630 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+#include "BlockSearch.h"
+#include "EpochBasedReclamation.h"
+#include "HeightGenerator.h"
+#include "NodeTower.h"
+#include "ShardedCounter.h"
+#include "SkipList.h"
+#include "SkipListStatistics.h"
+#include "SpinLock.h"
+
+/**
+ * Unrolled skip list: every node (a block) holds a sorted array of up to
+ * `BlockSize` values and a single tower, so that a search visits a node per
+ * `BlockSize` values and the bottom of the search is a scan of a contiguous
+ * array (BlockSearch, vectorized for integers) instead of a chain of cache
+ * misses.
+ *
+ * A block owns the values in [low, next->low), where `low` is fixed when the
+ * block is created and the head block is unbounded below. The values of a
+ * block are an immutable array which is replaced (copy-on-write) under the
+ * lock of the block, so lookups never lock: they read the array, the
+ * successor and the mark of the block between two reads of its fence
+ * version, which is odd while the range of the block changes.
+ *
+ * A block which grows beyond `BlockSize` values is split in half, a block
+ * which shrinks below a quarter of it is merged into its predecessor. Both
+ * lock the block and its predecessors on every level of the new or removed
+ * block, always in descending order of the blocks so that they cannot
+ * deadlock, and are skipped if the predecessors have changed meanwhile
+ * (the block then just stays larger or smaller). Replaced arrays and removed
+ * blocks are freed by EpochBasedReclamation.
+ *
+ * @tparam T Trivially copyable values
+ * @tparam BlockSize Maximum number of values per block, by default two cache
+ * lines
+ * @tparam HeightGenerator Policy which draws the height of new blocks
+ * @tparam Compare Strict weak ordering of the values
+ */
+template <typename T, std::uint16_t MaximumHeight,
+          std::size_t BlockSize = 128 / sizeof(T),
+          typename HeightGenerator = HalfHeightGenerator,
+          typename Compare = std::less<T>>
+class UnrolledSkipList final : public SkipList<T>
+{
+  public:
+    static_assert(MaximumHeight > 0, "Maximum height must be greater than 0");
+    static_assert(BlockSize >= 4, "Blocks must hold at least 4 values");
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Values must be trivially copyable");
+
+    using value_type = typename SkipList<T>::value_type;
+    using reference = typename SkipList<T>::reference;
+    using const_reference = typename SkipList<T>::const_reference;
+    using pointer = typename SkipList<T>::pointer;
+    using const_pointer = typename SkipList<T>::const_pointer;
+    using difference_type = typename SkipList<T>::difference_type;
+    using size_type = typename SkipList<T>::size_type;
+
+  private:
+    /**
+     * Sorted values of a block, followed by the values behind `values[0]`.
+     */
+    struct Values {
+        size_type count;
+        value_type values[1];
+    };
+
+    struct Block {
+        Block(const_reference low, std::uint16_t height)
+            : low(low)
+            , height(height)
+            , version(0)
+            , values(nullptr)
+            , marked(false)
+            , lock()
+            , next(height)
+        {
+        }
+
+        ~Block()
+        {
+            next.destroy(height);
+        }
+
+        const value_type low; // smallest value the block may hold
+        const std::uint16_t height;
+        std::atomic<std::uint32_t> version; // odd while the range changes
+        std::atomic<Values*> values;
+        std::atomic<bool> marked; // merged into its predecessor
+        TTASLock lock;
+        NodeTower<std::atomic<Block*>> next; // must be the last member
+    };
+
+    using Guard = EpochBasedReclamation::Guard;
+    using Search = BlockSearch<value_type, Compare>;
+    using Path = std::array<Block*, MaximumHeight>;
+
+  public:
+    UnrolledSkipList()
+        : m_head(createTowerNode<Block>(value_type(), MaximumHeight - 1))
+        , m_size()
+        , m_compare()
+        , m_reclamation()
+    {
+        m_head->values.store(createValues(0));
+        for (std::uint16_t level = 0; level < MaximumHeight; ++level) {
+            m_head->next[level].store(nullptr);
+        }
+    }
+
+    ~UnrolledSkipList()
+    {
+        m_reclamation.reclaimAll();
+        for (Block* block = m_head; block != nullptr;) {
+            Block* next = block->next[0].load();
+            destroyBlock(block);
+            block = next;
+        }
+    }
+
+    UnrolledSkipList(const UnrolledSkipList&) = delete;
+    UnrolledSkipList& operator=(const UnrolledSkipList&) = delete;
+
+    bool empty() override
+    {
+        return m_size.value() == 0;
+    }
+
+    size_type size() override
+    {
+        return m_size.value();
+    }
+
+    size_type sizeEstimate() override
+    {
+        return m_size.estimate();
+    }
+
+    bool insert(const_reference value) override
+    {
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().insertionStart();
+#endif
+        Guard guard(m_reclamation);
+
+        while (true) {
+            Block* block = findBlock(value);
+            std::unique_lock<TTASLock> lock(block->lock);
+#ifdef COLLECT_STATISTICS
+            SkipListStatistics::threadLocalInstance().lockAcquired();
+#endif
+            if (!owns(block, value)) {
+                lock.unlock();
+#ifdef COLLECT_STATISTICS
+                SkipListStatistics::threadLocalInstance().insertionRetry();
+#endif
+                continue;
+            }
+
+            Values* values = block->values.load();
+            const auto rank = this->rank(values, value);
+            if (holds(values, rank, value)) {
+#ifdef COLLECT_STATISTICS
+                SkipListStatistics::threadLocalInstance().insertionFailure();
+#endif
+                return false;
+            }
+
+            Values* updated = createValues(values->count + 1);
+            copyValues(updated->values, values->values, rank);
+            updated->values[rank] = value;
+            copyValues(updated->values + rank + 1, values->values + rank,
+                       values->count - rank);
+            block->values.store(updated);
+            retireValues(values);
+            ++m_size;
+
+            if (updated->count > BlockSize) {
+                split(block);
+            }
+#ifdef COLLECT_STATISTICS
+            SkipListStatistics::threadLocalInstance().insertionSuccess();
+#endif
+            return true;
+        }
+    }
+
+    bool remove(const_reference value) override
+    {
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().deletionStart();
+#endif
+        Guard guard(m_reclamation);
+
+        while (true) {
+            Block* block = findBlock(value);
+            std::unique_lock<TTASLock> lock(block->lock);
+#ifdef COLLECT_STATISTICS
+            SkipListStatistics::threadLocalInstance().lockAcquired();
+#endif
+            if (!owns(block, value)) {
+                lock.unlock();
+#ifdef COLLECT_STATISTICS
+                SkipListStatistics::threadLocalInstance().deletionRetry();
+#endif
+                continue;
+            }
+
+            Values* values = block->values.load();
+            const auto rank = this->rank(values, value);
+            if (!holds(values, rank, value)) {
+#ifdef COLLECT_STATISTICS
+                SkipListStatistics::threadLocalInstance().deletionFailure();
+#endif
+                return false;
+            }
+
+            Values* updated = createValues(values->count - 1);
+            copyValues(updated->values, values->values, rank);
+            copyValues(updated->values + rank, values->values + rank + 1,
+                       values->count - rank - 1);
+            block->values.store(updated);
+            retireValues(values);
+            --m_size;
+
+            if (block != m_head && updated->count < BlockSize / 4) {
+                merge(block);
+            }
+#ifdef COLLECT_STATISTICS
+            SkipListStatistics::threadLocalInstance().deletionSuccess();
+#endif
+            return true;
+        }
+    }
+
+    bool contains(const_reference value) override
+    {
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupStart();
+#endif
+        Guard guard(m_reclamation);
+
+        SpinBackoff backoff;
+        while (true) {
+            Block* block = findBlock(value);
+            Values* values;
+            Block* next;
+            if (snapshot(block, values, next) && isBefore(value, next)) {
+                const bool found = holds(values, rank(values, value), value);
+#ifdef COLLECT_STATISTICS
+                SkipListStatistics::threadLocalInstance().lookupDone();
+#endif
+                return found;
+            }
+#ifdef COLLECT_STATISTICS
+            SkipListStatistics::threadLocalInstance().lookupRetry();
+#endif
+            backoff();
+        }
+    }
+
+    size_type
+    rangeScan(const_reference lo, const_reference hi,
+              const std::function<void(const_reference)>& callback) override
+    {
+        if (!m_compare(lo, hi)) {
+            return 0;
+        }
+
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupStart();
+#endif
+        Guard guard(m_reclamation);
+
+        // `from` is the smallest value which has not been visited yet, a
+        // block which changes before it is read is searched again from there
+        value_type from = lo;
+        size_type count = 0;
+        Block* block = findBlock(from);
+        while (true) {
+            Values* values;
+            Block* next;
+            if (!snapshot(block, values, next)) {
+#ifdef COLLECT_STATISTICS
+                SkipListStatistics::threadLocalInstance().lookupRetry();
+#endif
+                block = findBlock(from);
+                continue;
+            }
+
+            for (auto i = rank(values, from);
+                 i < values->count && m_compare(values->values[i], hi); ++i) {
+                callback(values->values[i]);
+                ++count;
+            }
+            if (isBefore(hi, next)) {
+                break;
+            }
+            from = next->low;
+            block = next;
+        }
+
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lookupDone();
+#endif
+        return count;
+    }
+
+    /**
+     * Empties the blocks one after the other and merges them, values which
+     * are inserted concurrently behind the current block survive.
+     */
+    void clear() override
+    {
+        Guard guard(m_reclamation);
+
+        Block* block = m_head;
+        while (block != nullptr) {
+            std::unique_lock<TTASLock> lock(block->lock);
+            if (block->marked.load()) {
+                // merged meanwhile, its values have moved to the predecessor
+                lock.unlock();
+                block = findBlock(block->low);
+                continue;
+            }
+
+            Values* values = block->values.load();
+            block->values.store(createValues(0));
+            m_size.add(-static_cast<difference_type>(values->count));
+            retireValues(values);
+            Block* next = block->next[0].load();
+            if (block != m_head) {
+                merge(block);
+            }
+            block = next;
+        }
+    }
+
+    /**
+     * @return Number of blocks behind the head block, for tests
+     */
+    size_type numberOfBlocks()
+    {
+        Guard guard(m_reclamation);
+
+        size_type count = 0;
+        for (Block* block = m_head->next[0].load(); block != nullptr;
+             block = block->next[0].load()) {
+            ++count;
+        }
+        return count;
+    }
+
+  private:
+    static Values* createValues(size_type count)
+    {
+        const size_type extra = count > 0 ? count - 1 : 0;
+        void* memory =
+            ::operator new(sizeof(Values) + extra * sizeof(value_type));
+        Values* values = new (memory) Values();
+        values->count = count;
+        return values;
+    }
+
+    static void copyValues(value_type* target, const value_type* source,
+                           size_type count)
+    {
+        if (count > 0) {
+            std::memcpy(target, source, count * sizeof(value_type));
+        }
+    }
+
+    void retireValues(Values* values)
+    {
+        m_reclamation.retire(values, &reclaimValues, this);
+    }
+
+    static void reclaimValues(void*, void* pointer)
+    {
+        ::operator delete(pointer);
+    }
+
+    static void destroyBlock(Block* block)
+    {
+        ::operator delete(block->values.load());
+        destroyTowerNode(block);
+    }
+
+    static void reclaimBlock(void*, void* pointer)
+    {
+        auto* block = static_cast<Block*>(pointer);
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().nodeReclaimed(
+            towerNodeSize<Block>(block->height));
+#endif
+        destroyBlock(block);
+    }
+
+    size_type rank(const Values* values, const_reference value) const
+    {
+        return Search::rank(values->values, values->count, value, m_compare);
+    }
+
+    bool holds(const Values* values, size_type rank,
+               const_reference value) const
+    {
+        return rank < values->count &&
+               !m_compare(value, values->values[rank]);
+    }
+
+    /**
+     * @return true if `value` precedes the range of `block`, nullptr
+     * succeeds all values
+     */
+    bool isBefore(const_reference value, const Block* block) const
+    {
+        return block == nullptr || m_compare(value, block->low);
+    }
+
+    /**
+     * @return true if `block`, which must be locked and must not succeed
+     * `value`, still owns `value`
+     */
+    bool owns(Block* block, const_reference value) const
+    {
+        return !block->marked.load() && isBefore(value, block->next[0].load());
+    }
+
+    /**
+     * Reads the values and the successor of `block` as of a single point in
+     * time.
+     * @return false if the range of `block` has changed meanwhile
+     */
+    bool snapshot(Block* block, Values*& values, Block*& next) const
+    {
+        const auto version = block->version.load();
+        if ((version & 1) != 0) {
+            return false;
+        }
+        values = block->values.load();
+        next = block->next[0].load();
+        return !block->marked.load() && block->version.load() == version;
+    }
+
+    /**
+     * @return The last block whose `low` does not succeed `value`, i.e. the
+     * block which owns `value` unless it is being split or merged
+     */
+    Block* findBlock(const_reference value) const
+    {
+        Block* predecessor = m_head;
+        for (std::uint16_t level = MaximumHeight; level-- > 0;) {
+            Block* current = predecessor->next[level].load();
+            while (!isBefore(value, current)) {
+                predecessor = current;
+                current = predecessor->next[level].load();
+            }
+        }
+        return predecessor;
+    }
+
+    /**
+     * Fills `predecessors` and `successors` with the last blocks whose `low`
+     * precedes `value` and their successors on every level.
+     */
+    void findBlocks(const_reference value, Path& predecessors,
+                    Path& successors) const
+    {
+        Block* predecessor = m_head;
+        for (std::uint16_t level = MaximumHeight; level-- > 0;) {
+            Block* current = predecessor->next[level].load();
+            while (current != nullptr && m_compare(current->low, value)) {
+                predecessor = current;
+                current = predecessor->next[level].load();
+            }
+            predecessors[level] = predecessor;
+            successors[level] = current;
+        }
+    }
+
+    /**
+     * Locks `predecessors[1..height]` except of the blocks which are already
+     * locked, i.e. `predecessors[0]` and repeated ones.
+     */
+    void lockPredecessors(const Path& predecessors,
+                          std::uint16_t height) const
+    {
+        for (std::uint16_t level = 1; level <= height; ++level) {
+            if (predecessors[level] != predecessors[level - 1]) {
+                predecessors[level]->lock.lock();
+#ifdef COLLECT_STATISTICS
+                SkipListStatistics::threadLocalInstance().lockAcquired();
+#endif
+            }
+        }
+    }
+
+    void unlockPredecessors(const Path& predecessors,
+                            std::uint16_t height) const
+    {
+        for (std::uint16_t level = height; level >= 1; --level) {
+            if (predecessors[level] != predecessors[level - 1]) {
+                predecessors[level]->lock.unlock();
+            }
+        }
+    }
+
+    /**
+     * @return true if every predecessor is unmarked and still followed by
+     * its successor on the levels [0, height]
+     */
+    bool validate(const Path& predecessors, const Path& successors,
+                  std::uint16_t height) const
+    {
+        for (std::uint16_t level = 0; level <= height; ++level) {
+            if (predecessors[level]->marked.load() ||
+                predecessors[level]->next[level].load() != successors[level]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Moves the upper half of the values of the locked `block` to a new
+     * block behind it.
+     */
+    void split(Block* block)
+    {
+        Values* values = block->values.load();
+        const size_type half = values->count / 2;
+        const value_type low = values->values[half];
+        const auto height = HeightGenerator::template generate<MaximumHeight>();
+
+        Path predecessors;
+        Path successors;
+        findBlocks(low, predecessors, successors);
+        if (predecessors[0] != block) {
+            return;
+        }
+        lockPredecessors(predecessors, height);
+        if (validate(predecessors, successors, height)) {
+            Values* lower = createValues(half);
+            copyValues(lower->values, values->values, half);
+            Values* upper = createValues(values->count - half);
+            copyValues(upper->values, values->values + half,
+                       values->count - half);
+
+            Block* created = createTowerNode<Block>(low, height);
+            created->values.store(upper);
+            for (std::uint16_t level = 0; level <= height; ++level) {
+                created->next[level].store(successors[level]);
+            }
+
+            block->version.fetch_add(1);
+            for (std::uint16_t level = 0; level <= height; ++level) {
+                predecessors[level]->next[level].store(created);
+            }
+            block->values.store(lower);
+            block->version.fetch_add(1);
+            retireValues(values);
+        }
+        unlockPredecessors(predecessors, height);
+    }
+
+    /**
+     * Moves the values of the locked `block` to its predecessor and unlinks
+     * it, unless both together would exceed `BlockSize`.
+     */
+    void merge(Block* block)
+    {
+        Path predecessors;
+        Path successors;
+        findBlocks(block->low, predecessors, successors);
+
+        Block* predecessor = predecessors[0];
+        predecessor->lock.lock();
+#ifdef COLLECT_STATISTICS
+        SkipListStatistics::threadLocalInstance().lockAcquired();
+#endif
+        const auto height = block->height;
+        lockPredecessors(predecessors, height);
+
+        Values* values = block->values.load();
+        Values* previous = predecessor->values.load();
+        bool valid = validate(predecessors, successors, height) &&
+                     previous->count + values->count <= BlockSize;
+        for (std::uint16_t level = 0; valid && level <= height; ++level) {
+            valid = successors[level] == block;
+        }
+        if (valid) {
+            Values* merged = createValues(previous->count + values->count);
+            copyValues(merged->values, previous->values, previous->count);
+            copyValues(merged->values + previous->count, values->values,
+                       values->count);
+
+            predecessor->version.fetch_add(1);
+            block->version.fetch_add(1);
+            predecessor->values.store(merged);
+            block->marked.store(true);
+            for (std::uint16_t level = height + 1; level-- > 0;) {
+                predecessors[level]->next[level].store(
+                    block->next[level].load());
+            }
+            block->version.fetch_add(1);
+            predecessor->version.fetch_add(1);
+
+            retireValues(previous);
+            m_reclamation.retire(block, &reclaimBlock, this);
+        }
+        unlockPredecessors(predecessors, height);
+        predecessor->lock.unlock();
+    }
+
+  private:
+    Block* const m_head; // owns the values before the first block
+    ShardedCounter m_size;
+    Compare m_compare;
+    EpochBasedReclamation m_reclamation;
+};
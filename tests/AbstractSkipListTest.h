@@ -1,124 +1,308 @@
 #include <gtest/gtest.h>
+#include <memory>
+#include <vector>
 
-TEST_F(ABSTRACT_SKIP_LIST_TEST_IMPL, ShouldBeEmptyAfterInitialization)
+// The tests run on `ABSTRACT_SKIP_LIST_TEST_IMPL`, a fixture with a member
+// `std::unique_ptr<SkipList<int>> list`. Define `ABSTRACT_SKIP_LIST_TYPED_TEST`
+// as well if the fixture is a typed test case.
+#ifdef ABSTRACT_SKIP_LIST_TYPED_TEST
+#define ABSTRACT_SKIP_LIST_TEST(name)                                         \
+    TYPED_TEST(ABSTRACT_SKIP_LIST_TEST_IMPL, name)
+#else
+#define ABSTRACT_SKIP_LIST_TEST(name) TEST_F(ABSTRACT_SKIP_LIST_TEST_IMPL, name)
+#endif
+
+ABSTRACT_SKIP_LIST_TEST(ShouldBeEmptyAfterInitialization)
 {
-    EXPECT_TRUE(list->empty());
-    EXPECT_EQ(0, list->size());
+    EXPECT_TRUE(this->list->empty());
+    EXPECT_EQ(0, this->list->size());
 }
 
-TEST_F(ABSTRACT_SKIP_LIST_TEST_IMPL, ShouldNotBeEmptyAfterInsert)
+ABSTRACT_SKIP_LIST_TEST(ShouldNotBeEmptyAfterInsert)
 {
     // WHEN
-    list->insert(42);
+    this->list->insert(42);
 
     // THEN
-    EXPECT_FALSE(list->empty());
-    EXPECT_EQ(1, list->size());
+    EXPECT_FALSE(this->list->empty());
+    EXPECT_EQ(1, this->list->size());
 }
 
-TEST_F(ABSTRACT_SKIP_LIST_TEST_IMPL,
-       ShouldBeEmptyAfterRemovingLastElementInList)
+ABSTRACT_SKIP_LIST_TEST(ShouldBeEmptyAfterRemovingLastElementInList)
 {
     // PREPARE
-    list->insert(42);
+    this->list->insert(42);
 
     // WHEN
-    list->remove(42);
+    this->list->remove(42);
 
     // THEN
-    EXPECT_TRUE(list->empty());
-    EXPECT_EQ(0, list->size());
+    EXPECT_TRUE(this->list->empty());
+    EXPECT_EQ(0, this->list->size());
 }
 
-TEST_F(ABSTRACT_SKIP_LIST_TEST_IMPL, ShouldBeEmptyAfterClear)
+ABSTRACT_SKIP_LIST_TEST(ShouldBeEmptyAfterClear)
 {
     // PREPARE
-    list->insert(21);
-    list->insert(42);
+    this->list->insert(21);
+    this->list->insert(42);
 
     // WHEN
-    list->clear();
+    this->list->clear();
 
     // THEN
-    EXPECT_TRUE(list->empty());
-    EXPECT_EQ(0, list->size());
+    EXPECT_TRUE(this->list->empty());
+    EXPECT_EQ(0, this->list->size());
 }
 
-TEST_F(ABSTRACT_SKIP_LIST_TEST_IMPL, InsertingNonExistingElementShouldWork)
+ABSTRACT_SKIP_LIST_TEST(InsertingNonExistingElementShouldWork)
 {
     // WHEN
-    EXPECT_FALSE(list->contains(12));
+    EXPECT_FALSE(this->list->contains(12));
 
     // THEN
-    EXPECT_TRUE(list->insert(12));
+    EXPECT_TRUE(this->list->insert(12));
 }
 
-TEST_F(ABSTRACT_SKIP_LIST_TEST_IMPL, InsertingExistingElementShouldFail)
+ABSTRACT_SKIP_LIST_TEST(InsertingExistingElementShouldFail)
 {
     // WHEN
-    list->insert(12);
-    EXPECT_TRUE(list->contains(12));
+    this->list->insert(12);
+    EXPECT_TRUE(this->list->contains(12));
 
     // THEN
-    EXPECT_FALSE(list->insert(12));
+    EXPECT_FALSE(this->list->insert(12));
 }
 
-TEST_F(ABSTRACT_SKIP_LIST_TEST_IMPL, ShouldFindInsertedElement)
+ABSTRACT_SKIP_LIST_TEST(ShouldFindInsertedElement)
 {
     // WHEN
-    list->insert(42);
+    this->list->insert(42);
 
     // THEN
-    EXPECT_TRUE(list->contains(42));
+    EXPECT_TRUE(this->list->contains(42));
 }
 
-TEST_F(ABSTRACT_SKIP_LIST_TEST_IMPL, InsertingMultipleElementsShouldWork)
+ABSTRACT_SKIP_LIST_TEST(InsertingMultipleElementsShouldWork)
 {
     // WHEN
-    list->insert(12);
-    list->insert(42);
-    list->insert(21);
+    this->list->insert(12);
+    this->list->insert(42);
+    this->list->insert(21);
 
     // THEN
-    EXPECT_EQ(3, list->size());
-    EXPECT_TRUE(list->contains(12));
-    EXPECT_TRUE(list->contains(21));
-    EXPECT_TRUE(list->contains(42));
+    EXPECT_EQ(3, this->list->size());
+    EXPECT_TRUE(this->list->contains(12));
+    EXPECT_TRUE(this->list->contains(21));
+    EXPECT_TRUE(this->list->contains(42));
 }
 
-TEST_F(ABSTRACT_SKIP_LIST_TEST_IMPL, InsertingElementsAfterClearShouldWork)
+ABSTRACT_SKIP_LIST_TEST(InsertingElementsAfterClearShouldWork)
 {
     // PREPARE
     for (int i = 0; i < 3; i++) {
-        list->insert(i);
+        this->list->insert(i);
     }
-    list->clear();
+    this->list->clear();
 
     // WHEN
     for (int i = 0; i < 3; i++) {
-        EXPECT_TRUE(list->insert(i));
+        EXPECT_TRUE(this->list->insert(i));
+    }
+
+    // THEN
+    EXPECT_EQ(3, this->list->size());
+}
+
+ABSTRACT_SKIP_LIST_TEST(RemovingExistingElementShouldWork)
+{
+    // WHEN
+    this->list->insert(12);
+    EXPECT_TRUE(this->list->contains(12));
+
+    // THEN
+    EXPECT_TRUE(this->list->remove(12));
+    EXPECT_FALSE(this->list->contains(12));
+}
+
+ABSTRACT_SKIP_LIST_TEST(RemovingNonExistingElementShouldFail)
+{
+    // WHEN
+    EXPECT_FALSE(this->list->contains(12));
+
+    // THEN
+    EXPECT_FALSE(this->list->remove(12));
+}
+
+ABSTRACT_SKIP_LIST_TEST(RangeScanShouldVisitValuesInOrder)
+{
+    // PREPARE
+    for (int value : {42, 7, 12, 30, 21, 50}) {
+        this->list->insert(value);
+    }
+
+    // WHEN
+    std::vector<int> visited;
+    const auto count = this->list->rangeScan(
+        12, 42, [&](int value) { visited.push_back(value); });
+
+    // THEN [12, 42) is visited in ascending order
+    EXPECT_EQ(3, count);
+    EXPECT_EQ(std::vector<int>({12, 21, 30}), visited);
+    EXPECT_EQ(0, this->list->rangeScan(43, 50, [](int) {}));
+}
+
+ABSTRACT_SKIP_LIST_TEST(BulkLoadShouldInsertSortedValuesOnce)
+{
+    // PREPARE
+    const std::vector<int> values = {1, 2, 2, 3, 5, 8, 8, 8, 13};
+
+    // WHEN
+    const auto count = this->list->bulkLoad(values.data(), values.data() + 9);
+
+    // THEN
+    std::vector<int> visited;
+    this->list->rangeScan(0, 100, [&](int value) { visited.push_back(value); });
+    EXPECT_EQ(6, count);
+    EXPECT_EQ(6, this->list->size());
+    EXPECT_EQ(std::vector<int>({1, 2, 3, 5, 8, 13}), visited);
+
+    // the list is fully usable afterwards
+    EXPECT_TRUE(this->list->insert(4));
+    EXPECT_FALSE(this->list->insert(5));
+    EXPECT_TRUE(this->list->remove(8));
+    EXPECT_FALSE(this->list->contains(8));
+    EXPECT_TRUE(this->list->contains(13));
+    EXPECT_EQ(6, this->list->size());
+}
+
+ABSTRACT_SKIP_LIST_TEST(BulkLoadShouldMergeIntoNonEmptyList)
+{
+    // PREPARE
+    this->list->insert(3);
+    this->list->insert(10);
+    const std::vector<int> values = {1, 3, 5, 7};
+
+    // WHEN
+    const auto count = this->list->bulkLoad(values.data(), values.data() + 4);
+
+    // THEN
+    std::vector<int> visited;
+    this->list->rangeScan(0, 100, [&](int value) { visited.push_back(value); });
+    EXPECT_EQ(3, count);
+    EXPECT_EQ(std::vector<int>({1, 3, 5, 7, 10}), visited);
+}
+
+ABSTRACT_SKIP_LIST_TEST(InsertBatchShouldReportEveryValue)
+{
+    // PREPARE
+    this->list->insert(3);
+    const std::vector<int> values = {1, 3, 5, 5, 7};
+    bool results[5];
+
+    // WHEN
+    const auto count =
+        this->list->insertBatch(values.data(), values.data() + 5, results);
+
+    // THEN
+    std::vector<int> visited;
+    this->list->rangeScan(0, 100, [&](int value) { visited.push_back(value); });
+    EXPECT_EQ(3, count);
+    EXPECT_EQ(std::vector<int>({1, 3, 5, 7}), visited);
+    EXPECT_TRUE(results[0]);
+    EXPECT_FALSE(results[1]);
+    EXPECT_TRUE(results[2]);
+    EXPECT_FALSE(results[3]);
+    EXPECT_TRUE(results[4]);
+}
+
+ABSTRACT_SKIP_LIST_TEST(RemoveAndContainsBatchShouldReportEveryValue)
+{
+    // PREPARE
+    for (int value = 0; value < 100; value += 2) {
+        this->list->insert(value);
     }
+    const std::vector<int> values = {-1, 0, 1, 2, 2, 50, 98, 99};
+    bool results[8];
+
+    // WHEN
+    const auto contained =
+        this->list->containsBatch(values.data(), values.data() + 8, results);
 
     // THEN
-    EXPECT_EQ(3, list->size());
+    EXPECT_EQ(5, contained);
+    EXPECT_EQ(std::vector<bool>({false, true, false, true, true, true, true,
+                                 false}),
+              std::vector<bool>(results, results + 8));
+
+    // WHEN
+    const auto removed =
+        this->list->removeBatch(values.data(), values.data() + 8, results);
+
+    // THEN
+    EXPECT_EQ(4, removed);
+    EXPECT_EQ(std::vector<bool>({false, true, false, true, false, true, true,
+                                 false}),
+              std::vector<bool>(results, results + 8));
+    EXPECT_EQ(46, this->list->size());
+    EXPECT_FALSE(this->list->contains(50));
+    EXPECT_TRUE(this->list->contains(52));
 }
 
-TEST_F(ABSTRACT_SKIP_LIST_TEST_IMPL, RemovingExistingElementShouldWork)
+ABSTRACT_SKIP_LIST_TEST(BatchesShouldAcceptUnsortedValues)
 {
+    // PREPARE
+    const std::vector<int> values = {9, 4, 7, 1, 4, 8};
+    bool results[6];
+
     // WHEN
-    list->insert(12);
-    EXPECT_TRUE(list->contains(12));
+    const auto inserted =
+        this->list->insertBatch(values.data(), values.data() + 6, results);
+    const auto contained =
+        this->list->containsBatch(values.data(), values.data() + 6, results);
 
     // THEN
-    EXPECT_TRUE(list->remove(12));
-    EXPECT_FALSE(list->contains(12));
+    std::vector<int> visited;
+    this->list->rangeScan(0, 100, [&](int value) { visited.push_back(value); });
+    EXPECT_EQ(5, inserted);
+    EXPECT_EQ(6, contained);
+    EXPECT_EQ(std::vector<int>({1, 4, 7, 8, 9}), visited);
+
+    // WHEN
+    const auto removed =
+        this->list->removeBatch(values.data(), values.data() + 6, results);
+
+    // THEN
+    EXPECT_EQ(5, removed);
+    EXPECT_TRUE(this->list->empty());
 }
 
-TEST_F(ABSTRACT_SKIP_LIST_TEST_IMPL, RemovingNonExistingElementShouldFail)
+ABSTRACT_SKIP_LIST_TEST(ContainsManyShouldMatchContains)
 {
+    // PREPARE more probes than searches run at once, in scattered order
+    for (int value = 0; value < 300; value += 3) {
+        this->list->insert(value);
+    }
+    std::vector<int> values;
+    for (int i = 0; i < 622; ++i) {
+        values.push_back((i * 37) % 311);
+    }
+    std::unique_ptr<bool[]> results(new bool[values.size()]);
+
     // WHEN
-    EXPECT_FALSE(list->contains(12));
+    const auto contained = this->list->containsMany(
+        values.data(), values.data() + values.size(), results.get());
 
     // THEN
-    EXPECT_FALSE(list->remove(12));
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const bool isContained = values[i] < 300 && values[i] % 3 == 0;
+        EXPECT_EQ(isContained, results[i]) << values[i];
+        expected += isContained ? 1 : 0;
+    }
+    EXPECT_EQ(expected, contained);
+    EXPECT_EQ(0u, this->list->containsMany(values.data(), values.data(),
+                                           results.get()));
 }
+
+#undef ABSTRACT_SKIP_LIST_TEST
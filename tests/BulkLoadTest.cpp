@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "ConcurrentSkipList.h"
+#include "LazySkipList.h"
+#include "LockFreeSkipList.h"
+#include "SequentialSkipList.h"
+
+template <typename List>
+class BulkLoadTest : public ::testing::Test
+{
+  protected:
+    List list;
+};
+
+using BulkLoadImplementations = ::testing::Types<
+    SequentialSkipList<int, 16>,
+    SequentialSkipList<int, 16, SlabNodeAllocator<>>,
+    ConcurrentSkipList<int, 16>, LazySkipList<int, 16>,
+    LockFreeSkipList<int, 16>,
+    LockFreeSkipList<int, 16, HazardPointerReclamation, SlabNodeAllocator<>>,
+    LockFreeSkipList<int, 16, EpochBasedReclamation, HeapNodeAllocator,
+                     HalfHeightGenerator, std::less<int>,
+                     VersionedSnapshots>>;
+TYPED_TEST_CASE(BulkLoadTest, BulkLoadImplementations);
+
+TYPED_TEST(BulkLoadTest, ShouldConnectAllSegments)
+{
+    // PREPARE more values than a single segment holds, with duplicates at
+    // the segment boundaries
+    const int numberOfValues = 200000;
+    std::vector<int> values;
+    for (int value = 0; value < numberOfValues; ++value) {
+        values.push_back(2 * value);
+        if (value % 65536 == 0) {
+            values.push_back(2 * value);
+        }
+    }
+
+    // WHEN
+    const auto count =
+        this->list.bulkLoad(values.data(), values.data() + values.size());
+
+    // THEN
+    EXPECT_EQ(numberOfValues, count);
+    EXPECT_EQ(numberOfValues, this->list.size());
+    int expected = 0;
+    this->list.rangeScan(0, 2 * numberOfValues, [&](int value) {
+        EXPECT_EQ(expected, value);
+        expected += 2;
+    });
+    EXPECT_EQ(2 * numberOfValues, expected);
+    for (int value = 0; value < 2 * numberOfValues; value += 997) {
+        EXPECT_EQ(value % 2 == 0, this->list.contains(value)) << value;
+    }
+
+    // WHEN
+    EXPECT_TRUE(this->list.insert(2 * numberOfValues + 1));
+    EXPECT_TRUE(this->list.remove(2 * numberOfValues - 2));
+    EXPECT_TRUE(this->list.remove(0));
+
+    // THEN
+    EXPECT_EQ(numberOfValues - 1, this->list.size());
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ConcurrentSkipListMap.h"
+
+template <typename Map>
+class ConcurrentSkipListMapTest : public ::testing::Test
+{
+  protected:
+    Map map;
+};
+
+using MapImplementations =
+    ::testing::Types<LazySkipListMap<int, long, 16>,
+                     LockFreeSkipListMap<int, long, 16>,
+                     LockFreeSkipListMap<int, long, 16,
+                                         HazardPointerReclamation>>;
+TYPED_TEST_CASE(ConcurrentSkipListMapTest, MapImplementations);
+
+TYPED_TEST(ConcurrentSkipListMapTest, PutShouldInsertAndReplaceValues)
+{
+    // WHEN
+    const bool inserted = this->map.put(1, 10);
+    const bool replaced = !this->map.put(1, 11);
+
+    // THEN
+    long value = 0;
+    EXPECT_TRUE(inserted);
+    EXPECT_TRUE(replaced);
+    EXPECT_TRUE(this->map.get(1, value));
+    EXPECT_EQ(11, value);
+    EXPECT_FALSE(this->map.get(2, value));
+    EXPECT_EQ(1, this->map.size());
+}
+
+TYPED_TEST(ConcurrentSkipListMapTest, BulkLoadShouldInsertKeysWithValues)
+{
+    // PREPARE
+    std::vector<std::pair<int, long>> entries;
+    for (int key = 0; key < 1000; ++key) {
+        entries.emplace_back(key, 10L * key);
+    }
+
+    // WHEN
+    const auto count = this->map.bulkLoad(entries.begin(), entries.end());
+
+    // THEN
+    long value = 0;
+    EXPECT_EQ(1000, count);
+    EXPECT_EQ(1000, this->map.size());
+    EXPECT_TRUE(this->map.get(999, value));
+    EXPECT_EQ(9990, value);
+    EXPECT_FALSE(this->map.put(42, 1));
+    EXPECT_TRUE(this->map.remove(0));
+    EXPECT_FALSE(this->map.get(0, value));
+}
+
+TYPED_TEST(ConcurrentSkipListMapTest, PutIfAbsentShouldKeepExistingValue)
+{
+    // PREPARE
+    this->map.put(1, 10);
+
+    // WHEN
+    const bool inserted = this->map.putIfAbsent(1, 11);
+
+    // THEN
+    long value = 0;
+    EXPECT_FALSE(inserted);
+    EXPECT_TRUE(this->map.get(1, value));
+    EXPECT_EQ(10, value);
+}
+
+TYPED_TEST(ConcurrentSkipListMapTest, ComputeIfAbsentShouldOnlyComputeMissing)
+{
+    // PREPARE
+    this->map.put(1, 10);
+
+    // WHEN
+    const auto existing =
+        this->map.computeIfAbsent(1, [](int key) { return key * 100L; });
+    const auto computed =
+        this->map.computeIfAbsent(2, [](int key) { return key * 100L; });
+
+    // THEN
+    EXPECT_EQ(10, existing);
+    EXPECT_EQ(200, computed);
+    EXPECT_EQ(2, this->map.size());
+}
+
+TYPED_TEST(ConcurrentSkipListMapTest, UpdateShouldOnlyChangePresentKeys)
+{
+    // PREPARE
+    this->map.put(1, 10);
+
+    // WHEN
+    const bool updatedPresent =
+        this->map.update(1, [](long value) { return value * 2; });
+    const bool updatedAbsent =
+        this->map.update(2, [](long value) { return value * 2; });
+
+    // THEN
+    long value = 0;
+    EXPECT_TRUE(updatedPresent);
+    EXPECT_FALSE(updatedAbsent);
+    EXPECT_TRUE(this->map.get(1, value));
+    EXPECT_EQ(20, value);
+    EXPECT_FALSE(this->map.contains(2));
+}
+
+TYPED_TEST(ConcurrentSkipListMapTest, FetchAddShouldCountInParallel)
+{
+    // WHEN
+    const int numberOfThreads = 8;
+    const int numberOfKeys = 100;
+    const int rounds = 200;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&] {
+            for (int round = 0; round < rounds; ++round) {
+                for (int key = 0; key < numberOfKeys; ++key) {
+                    this->map.fetchAdd(key, 1);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_EQ(numberOfKeys, this->map.size());
+    for (int key = 0; key < numberOfKeys; ++key) {
+        long value = 0;
+        EXPECT_TRUE(this->map.get(key, value));
+        EXPECT_EQ(numberOfThreads * rounds, value);
+    }
+}
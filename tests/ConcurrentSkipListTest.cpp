@@ -42,3 +42,161 @@ TEST_F(ConcurrentSkipListTest, InsertingMultipleElementsInParallelShouldWork)
 
 #define ABSTRACT_SKIP_LIST_TEST_IMPL ConcurrentSkipListTest
 #include "AbstractSkipListTest.h"
+#undef ABSTRACT_SKIP_LIST_TEST_IMPL
+
+template <typename Locking>
+class ReadMostlySkipListTest : public ::testing::Test
+{
+  protected:
+    ConcurrentSkipList<int, 16, Locking> list;
+};
+
+using ReadMostlyLockings = ::testing::Types<SharedLocking, RcuLocking>;
+TYPED_TEST_CASE(ReadMostlySkipListTest, ReadMostlyLockings);
+
+TYPED_TEST(ReadMostlySkipListTest, ReadersShouldRunConcurrentlyWithWriters)
+{
+    // PREPARE the odd values, which are never removed
+    const int numberOfValues = 2000;
+    for (int value = 1; value < numberOfValues; value += 2) {
+        this->list.insert(value);
+    }
+
+    // WHEN writers insert and remove the even values while readers look up
+    // the odd ones
+    const int numberOfWriters = 2;
+    const int numberOfReaders = 6;
+    const int rounds = 5;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfWriters; i++) {
+        threads.emplace_back([&, i] {
+            for (int round = 0; round < rounds; ++round) {
+                for (int value = 2 * i; value < numberOfValues;
+                     value += 2 * numberOfWriters) {
+                    EXPECT_TRUE(this->list.insert(value));
+                }
+                for (int value = 2 * i; value < numberOfValues;
+                     value += 2 * numberOfWriters) {
+                    EXPECT_TRUE(this->list.remove(value));
+                }
+            }
+        });
+    }
+    for (int i = 0; i < numberOfReaders; i++) {
+        threads.emplace_back([&] {
+            for (int round = 0; round < rounds; ++round) {
+                for (int value = 1; value < numberOfValues; value += 2) {
+                    EXPECT_TRUE(this->list.contains(value));
+                }
+                int previous = -1;
+                std::size_t odd = 0;
+                this->list.rangeScan(0, numberOfValues, [&](int value) {
+                    EXPECT_LT(previous, value);
+                    previous = value;
+                    odd += value % 2;
+                });
+                EXPECT_EQ(numberOfValues / 2, odd);
+                EXPECT_LE(numberOfValues / 2, this->list.size());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_EQ(numberOfValues / 2, this->list.size());
+    EXPECT_FALSE(this->list.contains(0));
+}
+
+TYPED_TEST(ReadMostlySkipListTest, ReadersShouldRunConcurrentlyWithClear)
+{
+    // WHEN a writer fills and clears the list while readers scan it
+    const int numberOfValues = 1000;
+    const int rounds = 200;
+
+    std::vector<std::thread> threads;
+    threads.emplace_back([&] {
+        std::vector<int> values;
+        for (int value = 0; value < numberOfValues; ++value) {
+            values.push_back(value);
+        }
+        for (int round = 0; round < rounds; ++round) {
+            this->list.bulkLoad(values.data(), values.data() + values.size());
+            this->list.clear();
+        }
+    });
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&] {
+            for (int round = 0; round < rounds; ++round) {
+                int previous = -1;
+                this->list.rangeScan(0, numberOfValues, [&](int value) {
+                    EXPECT_LT(previous, value);
+                    previous = value;
+                });
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_TRUE(this->list.empty());
+}
+
+template <typename Locking>
+class QueueLockedSkipListTest : public ::testing::Test
+{
+  protected:
+    ConcurrentSkipList<int, 16, Locking> list;
+};
+
+using QueueLockings =
+    ::testing::Types<QueueLocking<TicketLock>, QueueLocking<MCSLock>,
+                     QueueLocking<CLHLock>>;
+TYPED_TEST_CASE(QueueLockedSkipListTest, QueueLockings);
+
+TYPED_TEST(QueueLockedSkipListTest,
+           InsertingAndRemovingMultipleElementsInParallelShouldWork)
+{
+    // WHEN
+    const int numberOfThreads = 8;
+    const int elementsPerThread = 500;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&, i] {
+            for (int j = i; j < numberOfThreads * elementsPerThread;
+                 j += numberOfThreads) {
+                EXPECT_TRUE(this->list.insert(j));
+                EXPECT_TRUE(this->list.contains(j));
+            }
+            for (int j = i; j < numberOfThreads * elementsPerThread;
+                 j += 2 * numberOfThreads) {
+                EXPECT_TRUE(this->list.remove(j));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_EQ(numberOfThreads * elementsPerThread / 2, this->list.size());
+}
+
+class RcuConcurrentSkipListTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        list = std::make_unique<ConcurrentSkipList<int, 16, RcuLocking>>();
+    }
+
+    std::unique_ptr<SkipList<int>> list;
+};
+
+#define ABSTRACT_SKIP_LIST_TEST_IMPL RcuConcurrentSkipListTest
+#include "AbstractSkipListTest.h"
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+#include "EpochBasedReclamation.h"
+
+class EpochBasedReclamationTest : public ::testing::Test
+{
+  protected:
+    static void countingDeleter(void* context, void*)
+    {
+        ++*static_cast<std::size_t*>(context);
+    }
+
+    void retire(EpochBasedReclamation& domain, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++) {
+            EpochGuard guard(domain);
+            domain.retire(&freed, &countingDeleter, &freed);
+        }
+    }
+
+    std::size_t freed = 0;
+};
+
+TEST_F(EpochBasedReclamationTest, ShouldFreeRetiredPointersOnDestruction)
+{
+    // WHEN
+    {
+        EpochBasedReclamation domain;
+        retire(domain, 10);
+    }
+
+    // THEN
+    EXPECT_EQ(10, freed);
+}
+
+TEST_F(EpochBasedReclamationTest, ShouldFreeRetiredPointersInBatches)
+{
+    // PREPARE
+    EpochBasedReclamation domain;
+
+    // WHEN
+    retire(domain, 10000);
+
+    // THEN
+    EXPECT_GT(freed, 0);
+    EXPECT_LT(freed, 10000);
+}
+
+TEST_F(EpochBasedReclamationTest,
+       ShouldNotFreeRetiredPointersWhileOtherThreadIsInCriticalRegion)
+{
+    // PREPARE
+    EpochBasedReclamation domain;
+
+    std::atomic_bool entered(false);
+    std::atomic_bool done(false);
+
+    std::thread reader([&] {
+        EpochGuard guard(domain);
+        entered = true;
+        while (!done) {
+            std::this_thread::yield();
+        }
+    });
+
+    while (!entered) {
+        std::this_thread::yield();
+    }
+
+    // WHEN
+    retire(domain, 10000);
+
+    // THEN
+    EXPECT_EQ(0, freed);
+
+    done = true;
+    reader.join();
+
+    retire(domain, 10000);
+    EXPECT_GT(freed, 0);
+}
+
+TEST_F(EpochBasedReclamationTest, ShouldChangeGenerationWhenEpochAdvances)
+{
+    // PREPARE
+    EpochBasedReclamation domain;
+    std::uint64_t generation = 0;
+    {
+        EpochGuard guard(domain);
+        generation = guard.generation();
+    }
+
+    // WHEN nothing is retired
+    // THEN
+    {
+        EpochGuard guard(domain);
+        EXPECT_NE(0, generation);
+        EXPECT_EQ(generation, guard.generation());
+    }
+
+    // WHEN enough pointers are retired to advance the epoch
+    retire(domain, 1000);
+
+    // THEN
+    EpochGuard guard(domain);
+    EXPECT_NE(generation, guard.generation());
+}
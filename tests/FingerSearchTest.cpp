@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "LazySkipList.h"
+#include "LockFreeSkipList.h"
+#include "SequentialSkipList.h"
+
+template <typename List>
+class FingerSearchTest : public ::testing::Test
+{
+  protected:
+    /**
+     * Checks that the list holds exactly the values of `expected`.
+     */
+    void expectValues(const std::set<int>& expected)
+    {
+        std::vector<int> visited;
+        list.rangeScan(-1000000, 1000000,
+                       [&](int value) { visited.push_back(value); });
+        EXPECT_EQ(std::vector<int>(expected.begin(), expected.end()),
+                  visited);
+        EXPECT_EQ(expected.size(), list.size());
+    }
+
+    List list;
+};
+
+using FingerSearchImplementations = ::testing::Types<
+    SequentialSkipList<int, 16, HeapNodeAllocator, HalfHeightGenerator,
+                       std::less<int>, ThreadFinger>,
+    LazySkipList<int, 16, HeapNodeAllocator, HalfHeightGenerator,
+                 std::less<int>, ThreadFinger>,
+    LockFreeSkipList<int, 16, EpochBasedReclamation, HeapNodeAllocator,
+                     HalfHeightGenerator, std::less<int>, NoSnapshots,
+                     ThreadFinger>,
+    LockFreeSkipList<int, 16, NoReclamation, SlabNodeAllocator<>,
+                     HalfHeightGenerator, std::less<int>, NoSnapshots,
+                     ThreadFinger>>;
+TYPED_TEST_CASE(FingerSearchTest, FingerSearchImplementations);
+
+TYPED_TEST(FingerSearchTest, ShouldInsertAscendingAndDescendingValues)
+{
+    // WHEN values are appended at the tail and prepended at the head
+    std::set<int> expected;
+    for (int value = 0; value < 2000; ++value) {
+        EXPECT_TRUE(this->list.insert(value));
+        EXPECT_TRUE(this->list.insert(-value - 1));
+        EXPECT_FALSE(this->list.insert(value));
+        expected.insert(value);
+        expected.insert(-value - 1);
+    }
+
+    // THEN
+    this->expectValues(expected);
+
+    // WHEN every other value is removed from the tail
+    for (int value = 1999; value >= 0; value -= 2) {
+        EXPECT_TRUE(this->list.remove(value));
+        EXPECT_FALSE(this->list.contains(value));
+        EXPECT_TRUE(this->list.contains(value - 1));
+        expected.erase(value);
+    }
+
+    // THEN
+    this->expectValues(expected);
+}
+
+TYPED_TEST(FingerSearchTest, ShouldMatchSetForRandomOperations)
+{
+    // WHEN operations jump around, so that the finger is mostly useless
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> values(0, 999);
+    std::set<int> expected;
+    for (int i = 0; i < 20000; ++i) {
+        const auto value = values(generator);
+        switch (i % 3) {
+        case 0:
+            EXPECT_EQ(expected.insert(value).second,
+                      this->list.insert(value));
+            break;
+        case 1:
+            EXPECT_EQ(expected.erase(value) == 1, this->list.remove(value));
+            break;
+        default:
+            EXPECT_EQ(expected.count(value) == 1, this->list.contains(value));
+        }
+    }
+
+    // THEN
+    this->expectValues(expected);
+}
+
+TYPED_TEST(FingerSearchTest, ShouldStartAgainAfterClear)
+{
+    // PREPARE
+    for (int value = 0; value < 100; ++value) {
+        this->list.insert(value);
+    }
+
+    // WHEN
+    this->list.clear();
+    EXPECT_TRUE(this->list.insert(50));
+    EXPECT_TRUE(this->list.insert(51));
+    EXPECT_FALSE(this->list.contains(49));
+
+    // THEN
+    this->expectValues({50, 51});
+}
+
+template <typename List>
+class ConcurrentFingerSearchTest : public ::testing::Test
+{
+  protected:
+    List list;
+};
+
+using ConcurrentFingerSearchImplementations = ::testing::Types<
+    LazySkipList<int, 16, HeapNodeAllocator, HalfHeightGenerator,
+                 std::less<int>, ThreadFinger>,
+    LazySkipList<int, 16, HeapNodeAllocator, HalfHeightGenerator,
+                 std::less<int>, ThreadFinger, OptimisticValidation>,
+    LockFreeSkipList<int, 16, EpochBasedReclamation, HeapNodeAllocator,
+                     HalfHeightGenerator, std::less<int>, NoSnapshots,
+                     ThreadFinger>>;
+TYPED_TEST_CASE(ConcurrentFingerSearchTest,
+                ConcurrentFingerSearchImplementations);
+
+TYPED_TEST(ConcurrentFingerSearchTest,
+           InsertingAndRemovingInterleavedValuesInParallelShouldWork)
+{
+    // WHEN every thread inserts and removes its interleaved values in
+    // ascending order, so the fingers of the threads point to nodes which
+    // other threads remove
+    const int numberOfThreads = 8;
+    const int elementsPerThread = 2000;
+    const int rounds = 5;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&, i] {
+            for (int round = 0; round < rounds; ++round) {
+                for (int j = i; j < numberOfThreads * elementsPerThread;
+                     j += numberOfThreads) {
+                    EXPECT_TRUE(this->list.insert(j));
+                }
+                for (int j = i; j < numberOfThreads * elementsPerThread;
+                     j += numberOfThreads) {
+                    EXPECT_TRUE(this->list.contains(j));
+                    EXPECT_TRUE(this->list.remove(j));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_TRUE(this->list.empty());
+    EXPECT_FALSE(this->list.contains(0));
+}
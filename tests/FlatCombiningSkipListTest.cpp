@@ -0,0 +1,92 @@
+#include <atomic>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "FlatCombiningSkipList.h"
+
+class FlatCombiningSkipListTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        list = std::make_unique<FlatCombiningSkipList<int, 16>>();
+    }
+
+    std::unique_ptr<SkipList<int>> list;
+};
+
+TEST_F(FlatCombiningSkipListTest,
+       InsertingAndRemovingMultipleElementsInParallelShouldWork)
+{
+    // WHEN
+    const int numberOfThreads = 8;
+    const int elementsPerThread = 500;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&, i] {
+            for (int j = i; j < numberOfThreads * elementsPerThread;
+                 j += numberOfThreads) {
+                EXPECT_TRUE(list->insert(j));
+                EXPECT_TRUE(list->contains(j));
+            }
+            for (int j = i; j < numberOfThreads * elementsPerThread;
+                 j += 2 * numberOfThreads) {
+                EXPECT_TRUE(list->remove(j));
+                EXPECT_FALSE(list->contains(j));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_EQ(numberOfThreads * elementsPerThread / 2, list->size());
+    for (int j = 0; j < numberOfThreads * elementsPerThread; ++j) {
+        EXPECT_EQ(j % (2 * numberOfThreads) >= numberOfThreads,
+                  list->contains(j));
+    }
+}
+
+TEST_F(FlatCombiningSkipListTest, ConflictingOperationsShouldKeepSizeConsistent)
+{
+    // WHEN all threads insert and remove the same few values, so that a
+    // combined batch holds several operations on the same value
+    const int numberOfThreads = 8;
+    const int numberOfValues = 16;
+    const int operationsPerThread = 5000;
+
+    std::atomic<int> inserted(0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&, i] {
+            int balance = 0;
+            for (int j = 0; j < operationsPerThread; ++j) {
+                const int value = (i + j) % numberOfValues;
+                if (j % 2 == 0) {
+                    balance += list->insert(value) ? 1 : 0;
+                } else {
+                    balance -= list->remove(value) ? 1 : 0;
+                }
+            }
+            inserted += balance;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_EQ(inserted.load(), list->size());
+    int found = 0;
+    for (int value = 0; value < numberOfValues; ++value) {
+        found += list->contains(value) ? 1 : 0;
+    }
+    EXPECT_EQ(inserted.load(), found);
+}
+
+#define ABSTRACT_SKIP_LIST_TEST_IMPL FlatCombiningSkipListTest
+#include "AbstractSkipListTest.h"
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <array>
+
+#include "HeightGenerator.h"
+
+template <typename Generator>
+static std::array<std::size_t, 8> heightHistogram(std::size_t samples)
+{
+    std::array<std::size_t, 8> histogram = {};
+    for (std::size_t i = 0; i < samples; ++i) {
+        const auto height = Generator::template generate<8>();
+        EXPECT_LT(height, 8);
+        ++histogram[height];
+    }
+    return histogram;
+}
+
+template <typename Generator>
+static void expectBranchingProbability(double probability)
+{
+    const std::size_t samples = 1000000;
+    const auto histogram = heightHistogram<Generator>(samples);
+
+    // P(height >= level) = probability^level
+    std::size_t atLeast = samples;
+    double expected = samples;
+    for (std::size_t level = 0; level < 4; ++level) {
+        EXPECT_NEAR(expected, atLeast, 0.01 * samples) << "level " << level;
+        atLeast -= histogram[level];
+        expected *= probability;
+    }
+}
+
+TEST(HeightGeneratorTest, HalfShouldPromoteEveryOtherNode)
+{
+    expectBranchingProbability<HalfHeightGenerator>(0.5);
+}
+
+TEST(HeightGeneratorTest, QuarterShouldPromoteEveryFourthNode)
+{
+    expectBranchingProbability<QuarterHeightGenerator>(0.25);
+}
+
+TEST(HeightGeneratorTest, InverseEShouldPromoteWithProbabilityOneOverE)
+{
+    expectBranchingProbability<InverseEHeightGenerator>(0.36787944117);
+}
+
+TEST(HeightGeneratorTest, ShouldNotExceedMaximumHeight)
+{
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(0, HalfHeightGenerator::generate<1>());
+        EXPECT_EQ(0, InverseEHeightGenerator::generate<1>());
+    }
+}
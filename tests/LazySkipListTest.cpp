@@ -5,18 +5,32 @@
 
 #include "LazySkipList.h"
 
+template <typename List>
 class LazySkipListTest : public ::testing::Test
 {
   protected:
     void SetUp() override
     {
-        list = std::make_unique<LazySkipList<int, 16>>();
+        list = std::make_unique<List>();
     }
 
     std::unique_ptr<SkipList<int>> list;
 };
 
-TEST_F(LazySkipListTest, InsertingMultipleElementsInParallelShouldWork)
+using LazySkipListImplementations = ::testing::Types<
+    LazySkipList<int, 16>,
+    LazySkipList<int, 16, HeapNodeAllocator, HalfHeightGenerator,
+                 std::less<int>, NoFinger, OptimisticValidation>,
+    LazySkipList<int, 16, HeapNodeAllocator, HalfHeightGenerator,
+                 std::less<int>, NoFinger, LockThenValidate,
+                 CachedSuccessorKeys>,
+    LazySkipList<int, 16, HeapNodeAllocator, HalfHeightGenerator,
+                 std::less<int>, NoFinger, LockThenValidate, NoSuccessorKeys,
+                 SuccessorPrefetching>,
+    LazySkipList<int, 64>>;
+TYPED_TEST_CASE(LazySkipListTest, LazySkipListImplementations);
+
+TYPED_TEST(LazySkipListTest, InsertingMultipleElementsInParallelShouldWork)
 {
     // WHEN
     const int numberOfThreads = 50;
@@ -28,7 +42,7 @@ TEST_F(LazySkipListTest, InsertingMultipleElementsInParallelShouldWork)
         const int end = start + elementsPerThread;
         threads.emplace_back([&, start, end] {
             for (int i = start; i < end; ++i) {
-                list->insert(i);
+                this->list->insert(i);
             }
         });
     }
@@ -37,8 +51,220 @@ TEST_F(LazySkipListTest, InsertingMultipleElementsInParallelShouldWork)
     }
 
     // THEN
-    EXPECT_EQ(numberOfThreads * elementsPerThread, list->size());
+    EXPECT_EQ(numberOfThreads * elementsPerThread, this->list->size());
+}
+
+TYPED_TEST(LazySkipListTest, InsertingAndRemovingElementsInParallelShouldWork)
+{
+    // WHEN the links of the values of other threads change meanwhile
+    const int numberOfThreads = 8;
+    const int elementsPerThread = 2000;
+    const int rounds = 3;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&, i] {
+            for (int round = 0; round < rounds; ++round) {
+                for (int j = i; j < numberOfThreads * elementsPerThread;
+                     j += numberOfThreads) {
+                    EXPECT_TRUE(this->list->insert(j));
+                    EXPECT_TRUE(this->list->contains(j));
+                }
+                for (int j = i; j < numberOfThreads * elementsPerThread;
+                     j += numberOfThreads) {
+                    EXPECT_TRUE(this->list->remove(j));
+                    EXPECT_FALSE(this->list->contains(j));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_TRUE(this->list->empty());
+    EXPECT_FALSE(this->list->contains(0));
+}
+
+TYPED_TEST(LazySkipListTest, ConflictingUpdatesShouldKeepSizeConsistent)
+{
+    // WHEN all threads insert and remove the same few values
+    const int numberOfThreads = 8;
+    const int operationsPerThread = 20000;
+    const int numberOfValues = 16;
+
+    std::vector<std::thread> threads;
+    std::vector<long> balances(numberOfThreads);
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&, i] {
+            for (int j = 0; j < operationsPerThread; ++j) {
+                const int value = (i + j) % numberOfValues;
+                if ((j / numberOfValues) % 2 == 0) {
+                    balances[i] += this->list->insert(value) ? 1 : 0;
+                } else {
+                    balances[i] -= this->list->remove(value) ? 1 : 0;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN every successful insert is matched by the content of the list
+    long balance = 0;
+    for (auto threadBalance : balances) {
+        balance += threadBalance;
+    }
+    std::size_t count = 0;
+    for (int value = 0; value < numberOfValues; ++value) {
+        count += this->list->contains(value) ? 1 : 0;
+    }
+    EXPECT_EQ(balance, static_cast<long>(count));
+    EXPECT_EQ(count, this->list->size());
+    EXPECT_EQ(count, this->list->rangeScan(0, numberOfValues, [](int) {}));
+}
+
+TYPED_TEST(LazySkipListTest, BatchesInParallelShouldWork)
+{
+    // WHEN every thread inserts and removes its interleaved values in batches
+    const int numberOfThreads = 8;
+    const int elementsPerThread = 2000;
+    const int rounds = 5;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&, i] {
+            std::vector<int> values;
+            for (int j = i; j < numberOfThreads * elementsPerThread;
+                 j += numberOfThreads) {
+                values.push_back(j);
+            }
+            std::unique_ptr<bool[]> results(new bool[values.size()]);
+            const auto* first = values.data();
+            const auto* last = first + values.size();
+            for (int round = 0; round < rounds; ++round) {
+                EXPECT_EQ(elementsPerThread, this->list->insertBatch(
+                                                 first, last, results.get()));
+                EXPECT_EQ(elementsPerThread, this->list->containsBatch(
+                                                 first, last, results.get()));
+                EXPECT_EQ(elementsPerThread, this->list->removeBatch(
+                                                 first, last, results.get()));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_TRUE(this->list->empty());
+}
+
+TYPED_TEST(LazySkipListTest, ContainsManyShouldSeeValuesDuringUpdates)
+{
+    // PREPARE even values which are never removed, probed in scattered order
+    const int numberOfValues = 4000;
+    for (int value = 0; value < numberOfValues; value += 2) {
+        this->list->insert(value);
+    }
+    std::vector<int> probes;
+    for (int i = 0; i < numberOfValues; ++i) {
+        probes.push_back((i * 1237) % numberOfValues);
+    }
+    const auto* first = probes.data();
+    const auto* last = first + probes.size();
+    std::unique_ptr<bool[]> results(new bool[probes.size()]);
+
+    // WHEN the odd values are inserted and removed meanwhile
+    std::vector<std::thread> writers;
+    for (int i = 0; i < 4; i++) {
+        writers.emplace_back([&, i] {
+            for (int round = 0; round < 3; ++round) {
+                for (int j = 2 * i + 1; j < numberOfValues; j += 8) {
+                    EXPECT_TRUE(this->list->insert(j));
+                }
+                for (int j = 2 * i + 1; j < numberOfValues; j += 8) {
+                    EXPECT_TRUE(this->list->remove(j));
+                }
+            }
+        });
+    }
+    for (int round = 0; round < 10; ++round) {
+        this->list->containsMany(first, last, results.get());
+        for (std::size_t i = 0; i < probes.size(); ++i) {
+            if (probes[i] % 2 == 0) {
+                EXPECT_TRUE(results[i]) << probes[i];
+            }
+        }
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    // THEN
+    EXPECT_EQ(numberOfValues / 2,
+              this->list->containsMany(first, last, results.get()));
+}
+
+TYPED_TEST(LazySkipListTest, SearchesShouldFollowRelinkedPredecessors)
+{
+    // PREPARE stable values, each followed by a successor of its own
+    const int numberOfValues = 4000;
+    for (int value = 0; value < numberOfValues; value += 2) {
+        this->list->insert(value);
+    }
+
+    // WHEN the successors are removed and new ones are inserted in their
+    // gap, which relinks the stable values; with cached successor keys their
+    // slots must take the key of every new successor
+    const int numberOfThreads = 4;
+    std::vector<std::thread> writers;
+    for (int i = 0; i < numberOfThreads; i++) {
+        writers.emplace_back([&, i] {
+            for (int round = 0; round < 3; ++round) {
+                for (int j = 4 * i; j < numberOfValues;
+                     j += 4 * numberOfThreads) {
+                    EXPECT_TRUE(this->list->remove(j + 2));
+                    EXPECT_TRUE(this->list->insert(j + 3));
+                    EXPECT_TRUE(this->list->insert(j + 1));
+                    EXPECT_TRUE(this->list->contains(j + 1));
+                    EXPECT_TRUE(this->list->contains(j + 3));
+                    EXPECT_FALSE(this->list->contains(j + 2));
+                    EXPECT_TRUE(this->list->remove(j + 1));
+                    EXPECT_TRUE(this->list->remove(j + 3));
+                    EXPECT_TRUE(this->list->insert(j + 2));
+                }
+            }
+        });
+    }
+    for (int round = 0; round < 10; ++round) {
+        for (int value = 0; value < numberOfValues; value += 4) {
+            EXPECT_TRUE(this->list->contains(value)) << value;
+        }
+        int previous = -1;
+        this->list->rangeScan(0, numberOfValues, [&](int value) {
+            EXPECT_LT(previous, value);
+            previous = value;
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    // THEN the successors are back in place
+    std::vector<int> visited;
+    this->list->rangeScan(0, numberOfValues,
+                          [&](int value) { visited.push_back(value); });
+    ASSERT_EQ(static_cast<std::size_t>(numberOfValues / 2), visited.size());
+    for (std::size_t i = 0; i < visited.size(); ++i) {
+        EXPECT_EQ(static_cast<int>(2 * i), visited[i]);
+    }
 }
 
 #define ABSTRACT_SKIP_LIST_TEST_IMPL LazySkipListTest
+#define ABSTRACT_SKIP_LIST_TYPED_TEST
 #include "AbstractSkipListTest.h"
+#undef ABSTRACT_SKIP_LIST_TYPED_TEST
+#undef ABSTRACT_SKIP_LIST_TEST_IMPL
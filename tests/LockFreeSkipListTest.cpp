@@ -41,5 +41,170 @@ TEST_F(LockFreeSkipListTest, InsertingMultipleElementsInParallelShouldWork)
     EXPECT_EQ(numberOfThreads * elementsPerThread, list->size());
 }
 
+template <typename List>
+class LockFreeSkipListReclamationTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        list = std::make_unique<List>();
+    }
+
+    std::unique_ptr<SkipList<int>> list;
+};
+
+using LockFreeSkipListImplementations = ::testing::Types<
+    LockFreeSkipList<int, 16>,
+    LockFreeSkipList<int, 16, HazardPointerReclamation>,
+    LockFreeSkipList<int, 16, EpochBasedReclamation, SlabNodeAllocator<>>,
+    LockFreeSkipList<int, 16, EpochBasedReclamation, HeapNodeAllocator,
+                     HalfHeightGenerator, std::less<int>, NoSnapshots,
+                     NoFinger, SuccessorPrefetching>,
+    LockFreeSkipList<int, 64>>;
+TYPED_TEST_CASE(LockFreeSkipListReclamationTest,
+                LockFreeSkipListImplementations);
+
+TYPED_TEST(LockFreeSkipListReclamationTest,
+           InsertingAndRemovingElementsInParallelShouldWork)
+{
+    // WHEN
+    const int numberOfThreads = 8;
+    const int elementsPerThread = 2000;
+    const int rounds = 5;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&, i] {
+            for (int round = 0; round < rounds; ++round) {
+                for (int j = i; j < numberOfThreads * elementsPerThread;
+                     j += numberOfThreads) {
+                    EXPECT_TRUE(this->list->insert(j));
+                    EXPECT_TRUE(this->list->contains(j));
+                }
+                for (int j = i; j < numberOfThreads * elementsPerThread;
+                     j += numberOfThreads) {
+                    EXPECT_TRUE(this->list->remove(j));
+                    EXPECT_FALSE(this->list->contains(j));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_TRUE(this->list->empty());
+    EXPECT_FALSE(this->list->contains(0));
+}
+
+TYPED_TEST(LockFreeSkipListReclamationTest, BatchesInParallelShouldWork)
+{
+    // WHEN every thread inserts and removes its interleaved values in batches
+    const int numberOfThreads = 8;
+    const int elementsPerThread = 2000;
+    const int rounds = 5;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&, i] {
+            std::vector<int> values;
+            for (int j = i; j < numberOfThreads * elementsPerThread;
+                 j += numberOfThreads) {
+                values.push_back(j);
+            }
+            std::unique_ptr<bool[]> results(new bool[values.size()]);
+            const auto* first = values.data();
+            const auto* last = first + values.size();
+            for (int round = 0; round < rounds; ++round) {
+                EXPECT_EQ(elementsPerThread, this->list->insertBatch(
+                                                 first, last, results.get()));
+                EXPECT_EQ(elementsPerThread, this->list->containsBatch(
+                                                 first, last, results.get()));
+                EXPECT_EQ(elementsPerThread, this->list->removeBatch(
+                                                 first, last, results.get()));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_TRUE(this->list->empty());
+}
+
+TYPED_TEST(LockFreeSkipListReclamationTest,
+           ContainsManyShouldSeeValuesDuringUpdates)
+{
+    // PREPARE even values which are never removed, probed in scattered order
+    const int numberOfValues = 4000;
+    for (int value = 0; value < numberOfValues; value += 2) {
+        this->list->insert(value);
+    }
+    std::vector<int> probes;
+    for (int i = 0; i < numberOfValues; ++i) {
+        probes.push_back((i * 1237) % numberOfValues);
+    }
+    const auto* first = probes.data();
+    const auto* last = first + probes.size();
+    std::unique_ptr<bool[]> results(new bool[probes.size()]);
+
+    // WHEN the odd values are inserted and removed meanwhile
+    std::vector<std::thread> writers;
+    for (int i = 0; i < 4; i++) {
+        writers.emplace_back([&, i] {
+            for (int round = 0; round < 3; ++round) {
+                for (int j = 2 * i + 1; j < numberOfValues; j += 8) {
+                    EXPECT_TRUE(this->list->insert(j));
+                }
+                for (int j = 2 * i + 1; j < numberOfValues; j += 8) {
+                    EXPECT_TRUE(this->list->remove(j));
+                }
+            }
+        });
+    }
+    for (int round = 0; round < 10; ++round) {
+        this->list->containsMany(first, last, results.get());
+        for (std::size_t i = 0; i < probes.size(); ++i) {
+            if (probes[i] % 2 == 0) {
+                EXPECT_TRUE(results[i]) << probes[i];
+            }
+        }
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    // THEN
+    EXPECT_EQ(numberOfValues / 2,
+              this->list->containsMany(first, last, results.get()));
+}
+
+TEST(SlabLockFreeSkipListTest, RemainingNodesShouldBeDroppedWithTheAllocator)
+{
+    // PREPARE
+    LockFreeSkipList<int, 16, EpochBasedReclamation, SlabNodeAllocator<>> list;
+    for (int i = 0; i < 10000; ++i) {
+        list.insert(i);
+    }
+
+    // WHEN
+    for (int i = 1; i < 10000; i += 2) {
+        list.remove(i);
+    }
+
+    // THEN the remaining nodes are dropped together with the allocator
+    EXPECT_EQ(5000, list.size());
+    EXPECT_TRUE(list.contains(0));
+}
+
 #define ABSTRACT_SKIP_LIST_TEST_IMPL LockFreeSkipListTest
 #include "AbstractSkipListTest.h"
+#undef ABSTRACT_SKIP_LIST_TEST_IMPL
+
+#define ABSTRACT_SKIP_LIST_TEST_IMPL LockFreeSkipListReclamationTest
+#define ABSTRACT_SKIP_LIST_TYPED_TEST
+#include "AbstractSkipListTest.h"
+#undef ABSTRACT_SKIP_LIST_TYPED_TEST
+#undef ABSTRACT_SKIP_LIST_TEST_IMPL
@@ -0,0 +1,140 @@
+#include <atomic>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "NoHotSpotSkipList.h"
+
+class NoHotSpotSkipListTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        list = std::make_unique<NoHotSpotSkipList<int, 16>>();
+    }
+
+    std::unique_ptr<SkipList<int>> list;
+};
+
+TEST_F(NoHotSpotSkipListTest,
+       InsertingAndRemovingMultipleElementsInParallelShouldWork)
+{
+    // WHEN the threads insert and remove while the index is maintained
+    const int numberOfThreads = 8;
+    const int elementsPerThread = 2000;
+    const int rounds = 3;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&, i] {
+            for (int round = 0; round < rounds; ++round) {
+                for (int j = i; j < numberOfThreads * elementsPerThread;
+                     j += numberOfThreads) {
+                    EXPECT_TRUE(list->insert(j));
+                }
+                for (int j = i; j < numberOfThreads * elementsPerThread;
+                     j += numberOfThreads) {
+                    EXPECT_TRUE(list->contains(j));
+                    EXPECT_TRUE(list->remove(j));
+                    EXPECT_FALSE(list->contains(j));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_TRUE(list->empty());
+}
+
+TEST_F(NoHotSpotSkipListTest, ConflictingUpdatesShouldKeepSizeConsistent)
+{
+    // WHEN all threads insert and remove the same few values, so that
+    // deleted nodes are revived and removed nodes are unlinked meanwhile
+    const int numberOfThreads = 8;
+    const int numberOfValues = 16;
+    const int operationsPerThread = 20000;
+
+    std::atomic<int> inserted(0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&, i] {
+            int balance = 0;
+            for (int j = 0; j < operationsPerThread; ++j) {
+                const int value = (i + j) % numberOfValues;
+                if (j % 2 == 0) {
+                    balance += list->insert(value) ? 1 : 0;
+                } else {
+                    balance -= list->remove(value) ? 1 : 0;
+                }
+            }
+            inserted += balance;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_EQ(inserted.load(), list->size());
+    EXPECT_EQ(inserted.load(), list->rangeScan(0, numberOfValues, [](int) {}));
+}
+
+TEST(NoHotSpotSkipListIndexTest, MaintenanceShouldRaiseAndLowerTowers)
+{
+    // PREPARE
+    NoHotSpotSkipList<int, 16> list;
+    const int numberOfValues = 10000;
+    for (int value = 0; value < numberOfValues; ++value) {
+        list.insert(value);
+    }
+
+    // WHEN
+    list.maintain();
+
+    // THEN every level holds a third to a half of the level below
+    EXPECT_GE(list.height(), 8);
+    EXPECT_LE(list.height(), 14);
+
+    // WHEN
+    for (int value = 0; value < numberOfValues; ++value) {
+        if (value % 1000 != 0) {
+            EXPECT_TRUE(list.remove(value));
+        }
+    }
+    list.maintain();
+
+    // THEN
+    EXPECT_LE(list.height(), 4);
+    EXPECT_EQ(10, list.size());
+    std::vector<int> visited;
+    list.rangeScan(0, numberOfValues,
+                   [&](int value) { visited.push_back(value); });
+    EXPECT_EQ((std::vector<int>{0, 1000, 2000, 3000, 4000, 5000, 6000, 7000,
+                                8000, 9000}),
+              visited);
+}
+
+TEST(NoHotSpotSkipListIndexTest, DeletedValuesShouldBeRevived)
+{
+    // PREPARE
+    NoHotSpotSkipList<int, 16> list;
+    list.insert(1);
+    list.insert(2);
+    list.remove(1);
+
+    // WHEN the value is inserted again before the node has been unlinked
+    EXPECT_TRUE(list.insert(1));
+    EXPECT_FALSE(list.insert(1));
+
+    // THEN
+    list.maintain();
+    EXPECT_TRUE(list.contains(1));
+    EXPECT_EQ(2, list.size());
+}
+
+#define ABSTRACT_SKIP_LIST_TEST_IMPL NoHotSpotSkipListTest
+#include "AbstractSkipListTest.h"
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "LazySkipList.h"
+#include "LockFreeSkipList.h"
+#include "PartitionedSkipList.h"
+#include "SequentialSkipList.h"
+
+class PartitionedSkipListTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        // boundaries on the values of the tests below, so that their scans
+        // and batches span several shards
+        list = std::make_unique<PartitionedSkipList<LazySkipList<int, 16>>>(
+            std::vector<int>{5, 12, 21, 40, 42});
+    }
+
+    std::unique_ptr<SkipList<int>> list;
+};
+
+TEST_F(PartitionedSkipListTest, InsertingAndRemovingInParallelShouldWork)
+{
+    // WHEN every thread works on values of all shards
+    const int numberOfThreads = 8;
+    const int elementsPerThread = 500;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&, i] {
+            for (int j = i - 96; j < numberOfThreads * elementsPerThread;
+                 j += numberOfThreads) {
+                EXPECT_TRUE(list->insert(j));
+                EXPECT_TRUE(list->contains(j));
+            }
+            for (int j = i - 96; j < numberOfThreads * elementsPerThread;
+                 j += 2 * numberOfThreads) {
+                EXPECT_TRUE(list->remove(j));
+                EXPECT_FALSE(list->contains(j));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_EQ((numberOfThreads * elementsPerThread + 96) / 2, list->size());
+}
+
+TEST_F(PartitionedSkipListTest, RangeScanShouldVisitShardsInOrder)
+{
+    // PREPARE
+    for (int value = 50; value >= -10; --value) {
+        list->insert(value);
+    }
+
+    // WHEN
+    std::vector<int> visited;
+    const auto count =
+        list->rangeScan(3, 44, [&](int value) { visited.push_back(value); });
+
+    // THEN
+    std::vector<int> expected;
+    for (int value = 3; value < 44; ++value) {
+        expected.push_back(value);
+    }
+    EXPECT_EQ(expected, visited);
+    EXPECT_EQ(expected.size(), count);
+    EXPECT_EQ(0, list->rangeScan(44, 3, [](int) {}));
+}
+
+TEST_F(PartitionedSkipListTest, BatchesShouldReportValuesOfAllShards)
+{
+    // PREPARE
+    const std::vector<int> values = {-3, 4, 5, 11, 12, 13, 30, 41, 42, 99};
+    list->insert(5);
+    list->insert(42);
+
+    // WHEN
+    bool results[10];
+    const auto inserted =
+        list->insertBatch(values.data(), values.data() + 10, results);
+
+    // THEN
+    EXPECT_EQ(8, inserted);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i] != 5 && values[i] != 42, results[i]);
+    }
+
+    // WHEN
+    const std::vector<int> removals = {4, 12, 20, 42, 100};
+    const auto removed =
+        list->removeBatch(removals.data(), removals.data() + 5, results);
+
+    // THEN
+    EXPECT_EQ(3, removed);
+    EXPECT_EQ((std::vector<bool>{true, true, false, true, false}),
+              std::vector<bool>(results, results + 5));
+    const auto contained =
+        list->containsBatch(values.data(), values.data() + 10, results);
+    EXPECT_EQ(7, contained);
+    EXPECT_EQ(7, list->size());
+}
+
+TEST(PartitionedSkipListRoutingTest, EvenBoundariesShouldSplitTheRange)
+{
+    // WHEN
+    using List = PartitionedSkipList<SequentialSkipList<long, 16>>;
+    const auto boundaries = List::evenBoundaries(0, 1000, 4);
+
+    // THEN
+    EXPECT_EQ((std::vector<long>{250, 500, 750}), boundaries);
+    EXPECT_EQ(4, List(boundaries).numberOfShards());
+    EXPECT_EQ(1, List({}).numberOfShards());
+}
+
+TEST(PartitionedSkipListRoutingTest, ShouldWorkWithLockFreeShards)
+{
+    // PREPARE
+    using Inner = LockFreeSkipList<long, 16, EpochBasedReclamation>;
+    PartitionedSkipList<Inner> list(
+        PartitionedSkipList<Inner>::evenBoundaries(0, 8000, 8));
+
+    // WHEN every thread inserts a range of its own shard
+    const int numberOfThreads = 8;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&, i] {
+            for (long value = i * 1000; value < (i + 1) * 1000; ++value) {
+                EXPECT_TRUE(list.insert(value));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_EQ(8000, list.size());
+    long expected = 0;
+    list.rangeScan(0, 8000,
+                   [&](long value) { EXPECT_EQ(expected++, value); });
+    EXPECT_EQ(8000, expected);
+}
+
+#define ABSTRACT_SKIP_LIST_TEST_IMPL PartitionedSkipListTest
+#include "AbstractSkipListTest.h"
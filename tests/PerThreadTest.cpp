@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "PerThread.h"
+
+TEST(PerThreadTest, AlternatingObjectsShouldKeepTheirRecords)
+{
+    // PREPARE more objects than records are cached per thread
+    const int numberOfObjects = 20;
+    std::vector<std::unique_ptr<PerThread<int>>> objects;
+    for (int i = 0; i < numberOfObjects; ++i) {
+        objects.emplace_back(new PerThread<int>());
+    }
+
+    // WHEN every thread alternates between the objects
+    const int numberOfThreads = 4;
+    const int rounds = 100;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; ++i) {
+        threads.emplace_back([&, i] {
+            for (int round = 0; round < rounds; ++round) {
+                for (int j = 0; j < numberOfObjects; ++j) {
+                    // the record of an object must not be one of another
+                    EXPECT_EQ(round * (j + 1), objects[j]->local());
+                    objects[j]->local() += j + 1;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN every object has one record per thread
+    for (int j = 0; j < numberOfObjects; ++j) {
+        EXPECT_EQ(static_cast<std::size_t>(numberOfThreads),
+                  objects[j]->size());
+        objects[j]->forEach(
+            [&](int record) { EXPECT_EQ(rounds * (j + 1), record); });
+    }
+}
+
+TEST(PerThreadTest, NewObjectShouldNotSeeRecordsOfADestroyedOne)
+{
+    // PREPARE
+    std::unique_ptr<PerThread<int>> object(new PerThread<int>());
+    object->local() = 42;
+
+    // WHEN
+    object.reset(new PerThread<int>());
+
+    // THEN
+    EXPECT_EQ(0, object->local());
+    EXPECT_EQ(1u, object->size());
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "ConcurrentSkipListMap.h"
+#include "LazySkipList.h"
+#include "LockFreeSkipList.h"
+
+template <typename List>
+class RangeScanTest : public ::testing::Test
+{
+  protected:
+    List list;
+};
+
+using RangeScanImplementations =
+    ::testing::Types<LazySkipList<int, 16>, LockFreeSkipList<int, 16>,
+                     LockFreeSkipList<int, 16, HazardPointerReclamation>>;
+TYPED_TEST_CASE(RangeScanTest, RangeScanImplementations);
+
+TYPED_TEST(RangeScanTest, ShouldSkipRemovedValues)
+{
+    // PREPARE
+    for (int i = 0; i < 100; ++i) {
+        this->list.insert(i);
+    }
+    for (int i = 0; i < 100; i += 3) {
+        this->list.remove(i);
+    }
+
+    // WHEN
+    std::vector<int> visited;
+    this->list.rangeScan(10, 20, [&](int value) { visited.push_back(value); });
+
+    // THEN
+    EXPECT_EQ(std::vector<int>({10, 11, 13, 14, 16, 17, 19}), visited);
+}
+
+TYPED_TEST(RangeScanTest, ShouldVisitStableValuesDuringConcurrentUpdates)
+{
+    // PREPARE even values stay in the list, odd values come and go
+    const int numberOfValues = 2000;
+    for (int i = 0; i < numberOfValues; i += 2) {
+        this->list.insert(i);
+    }
+
+    // WHEN
+    std::atomic<bool> done(false);
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&, t] {
+            while (!done) {
+                for (int i = 2 * t + 1; i < numberOfValues; i += 8) {
+                    this->list.insert(i);
+                }
+                for (int i = 2 * t + 1; i < numberOfValues; i += 8) {
+                    this->list.remove(i);
+                }
+            }
+        });
+    }
+
+    for (int round = 0; round < 50; ++round) {
+        std::vector<int> visited;
+        this->list.rangeScan(0, numberOfValues,
+                             [&](int value) { visited.push_back(value); });
+
+        // THEN values are visited once, in order and all stable ones are
+        std::size_t even = 0;
+        for (std::size_t i = 0; i < visited.size(); ++i) {
+            if (i > 0) {
+                ASSERT_LT(visited[i - 1], visited[i]);
+            }
+            even += visited[i] % 2 == 0;
+        }
+        ASSERT_EQ(numberOfValues / 2, even);
+    }
+
+    done = true;
+    for (auto& writer : writers) {
+        writer.join();
+    }
+}
+
+template <typename List>
+class IteratorTest : public ::testing::Test
+{
+  protected:
+    List list;
+};
+
+using IteratorImplementations =
+    ::testing::Types<LazySkipList<int, 16>, LockFreeSkipList<int, 16>>;
+TYPED_TEST_CASE(IteratorTest, IteratorImplementations);
+
+TYPED_TEST(IteratorTest, ShouldIterateInOrder)
+{
+    // PREPARE
+    for (int value : {5, 1, 4, 2, 3}) {
+        this->list.insert(value);
+    }
+    this->list.remove(4);
+
+    // WHEN
+    std::vector<int> visited(this->list.begin(), this->list.end());
+
+    // THEN
+    EXPECT_EQ(std::vector<int>({1, 2, 3, 5}), visited);
+}
+
+TYPED_TEST(IteratorTest, BoundsShouldStartAtTheRightValue)
+{
+    // PREPARE
+    for (int value : {10, 20, 30}) {
+        this->list.insert(value);
+    }
+
+    // THEN
+    EXPECT_EQ(20, *this->list.lower_bound(20));
+    EXPECT_EQ(30, *this->list.upper_bound(20));
+    EXPECT_EQ(10, *this->list.lower_bound(0));
+    EXPECT_EQ(20, *this->list.upper_bound(15));
+    EXPECT_TRUE(this->list.upper_bound(30) == this->list.end());
+    EXPECT_TRUE(this->list.lower_bound(31) == this->list.end());
+}
+
+TYPED_TEST(IteratorTest, CopiesShouldAdvanceIndependently)
+{
+    // PREPARE
+    for (int value : {1, 2, 3}) {
+        this->list.insert(value);
+    }
+
+    // WHEN
+    auto first = this->list.begin();
+    auto second = first;
+    ++second;
+
+    // THEN
+    EXPECT_EQ(1, *first);
+    EXPECT_EQ(2, *second);
+    EXPECT_EQ(3, *++second);
+    EXPECT_TRUE(++second == this->list.end());
+    EXPECT_EQ(1, *first);
+}
+
+TEST(MapRangeScanTest, ShouldVisitKeysWithValues)
+{
+    // PREPARE
+    LockFreeSkipListMap<int, long, 16> map;
+    for (int i = 0; i < 10; ++i) {
+        map.put(i, 10 * i);
+    }
+
+    // WHEN
+    long sum = 0;
+    const auto count = map.rangeScan(2, 5, [&](int, long value) {
+        sum += value;
+    });
+
+    // THEN
+    EXPECT_EQ(3, count);
+    EXPECT_EQ(20 + 30 + 40, sum);
+    EXPECT_EQ(70, map.lower_bound(7).mapped().load());
+}
@@ -3,16 +3,69 @@
 
 #include "SequentialSkipList.h"
 
+template <typename List>
 class SequentialSkipListTest : public ::testing::Test
 {
   protected:
     void SetUp() override
     {
-        list = std::make_unique<SequentialSkipList<int, 16>>();
+        list = std::make_unique<List>();
     }
 
     std::unique_ptr<SkipList<int>> list;
 };
 
+using SequentialSkipListImplementations = ::testing::Types<
+    SequentialSkipList<int, 16>,
+    SequentialSkipList<int, 16, SlabNodeAllocator<>>,
+    SequentialSkipList<int, 16, HeapNodeAllocator, HalfHeightGenerator,
+                       std::less<int>, NoFinger, ExclusiveAccess,
+                       CachedSuccessorKeys>>;
+TYPED_TEST_CASE(SequentialSkipListTest, SequentialSkipListImplementations);
+
+TYPED_TEST(SequentialSkipListTest, CachedValuesShouldFollowTheLinks)
+{
+    // PREPARE
+    for (int i = 0; i < 10000; i += 2) {
+        this->list->insert(i);
+    }
+    for (int i = 0; i < 10000; i += 4) {
+        this->list->remove(i);
+    }
+
+    // WHEN values are inserted between the remaining ones
+    for (int i = 1; i < 10000; i += 4) {
+        this->list->insert(i);
+    }
+
+    // THEN
+    for (int i = 0; i < 10000; ++i) {
+        EXPECT_EQ(i % 4 == 1 || i % 4 == 2, this->list->contains(i)) << i;
+    }
+    EXPECT_EQ(5000, this->list->size());
+}
+
+TYPED_TEST(SequentialSkipListTest, ShouldReuseListAfterClear)
+{
+    // PREPARE
+    for (int i = 0; i < 10000; ++i) {
+        this->list->insert(i);
+    }
+
+    // WHEN
+    this->list->clear();
+    for (int i = 0; i < 10000; i += 2) {
+        this->list->insert(i);
+    }
+
+    // THEN
+    EXPECT_EQ(5000, this->list->size());
+    EXPECT_TRUE(this->list->contains(9998));
+    EXPECT_FALSE(this->list->contains(9999));
+}
+
 #define ABSTRACT_SKIP_LIST_TEST_IMPL SequentialSkipListTest
+#define ABSTRACT_SKIP_LIST_TYPED_TEST
 #include "AbstractSkipListTest.h"
+#undef ABSTRACT_SKIP_LIST_TYPED_TEST
+#undef ABSTRACT_SKIP_LIST_TEST_IMPL
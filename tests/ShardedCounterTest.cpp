@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "ShardedCounter.h"
+
+TEST(ShardedCounterTest, ShouldSumUpdatesOfAllThreads)
+{
+    // PREPARE
+    ShardedCounter counter;
+    const int numberOfThreads = 8;
+    const int incrementsPerThread = 10000;
+
+    // WHEN
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&, i] {
+            for (int j = 0; j < incrementsPerThread; ++j) {
+                ++counter;
+            }
+            // odd threads remove their elements again
+            for (int j = 0; i % 2 == 1 && j < incrementsPerThread; ++j) {
+                --counter;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    const std::size_t expected = numberOfThreads / 2 * incrementsPerThread;
+    EXPECT_EQ(expected, counter.value());
+    EXPECT_LE(expected - numberOfThreads * ShardedCounter::EstimateBatchSize,
+              counter.estimate());
+    EXPECT_GE(expected + numberOfThreads * ShardedCounter::EstimateBatchSize,
+              counter.estimate());
+}
+
+TEST(ShardedCounterTest, ShouldNeverBecomeNegative)
+{
+    // PREPARE
+    ShardedCounter counter;
+
+    // WHEN decremented by another thread than the incrementing one
+    ++counter;
+    std::thread([&] {
+        --counter;
+        --counter;
+    }).join();
+
+    // THEN
+    EXPECT_EQ(0, counter.value());
+    EXPECT_EQ(0, counter.estimate());
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "SpinLock.h"
+
+TEST(SpinLockTest, TTASLockShouldBeSmall)
+{
+    EXPECT_EQ(1, sizeof(TTASLock));
+}
+
+TEST(SpinLockTest, TTASLockShouldExcludeOtherThreads)
+{
+    // PREPARE
+    TTASLock lock;
+    std::size_t counter = 0;
+    const int numberOfThreads = 8;
+    const int incrementsPerThread = 10000;
+
+    // WHEN
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < incrementsPerThread; ++j) {
+                std::lock_guard<TTASLock> guard(lock);
+                ++counter;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_EQ(numberOfThreads * incrementsPerThread, counter);
+}
+
+TEST(SpinLockTest, TryLockShouldFailWhileLocked)
+{
+    // PREPARE
+    TTASLock lock;
+
+    // WHEN
+    lock.lock();
+
+    // THEN
+    EXPECT_FALSE(lock.try_lock());
+    lock.unlock();
+    EXPECT_TRUE(lock.try_lock());
+    lock.unlock();
+}
+
+TEST(SpinLockTest, VersionedLockShouldExcludeOtherThreads)
+{
+    // PREPARE
+    VersionedLock lock;
+    std::size_t counter = 0;
+    const int numberOfThreads = 8;
+    const int incrementsPerThread = 10000;
+
+    // WHEN
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < incrementsPerThread; ++j) {
+                std::lock_guard<VersionedLock> guard(lock);
+                ++counter;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_EQ(numberOfThreads * incrementsPerThread, counter);
+    EXPECT_EQ(2u * numberOfThreads * incrementsPerThread, lock.version());
+}
+
+TEST(SpinLockTest, VersionedLockShouldOnlyLockUnchangedVersion)
+{
+    // PREPARE
+    VersionedLock lock;
+    const auto version = lock.version();
+
+    // WHEN another thread locks and unlocks in between
+    lock.lock();
+    EXPECT_FALSE(lock.isVersion(lock.version()));
+    EXPECT_FALSE(lock.tryLock(lock.version()));
+    lock.unlock();
+
+    // THEN the old version can't be locked anymore, the new one can
+    EXPECT_FALSE(lock.isVersion(version));
+    EXPECT_FALSE(lock.tryLock(version));
+    const auto newVersion = lock.version();
+    EXPECT_TRUE(lock.isVersion(newVersion));
+    EXPECT_TRUE(lock.tryLock(newVersion));
+    lock.unlock();
+}
+
+template <typename Lock>
+class QueueLockTest : public ::testing::Test
+{
+};
+
+using QueueLocks = ::testing::Types<TicketLock, MCSLock, CLHLock>;
+TYPED_TEST_CASE(QueueLockTest, QueueLocks);
+
+TYPED_TEST(QueueLockTest, ShouldExcludeOtherThreads)
+{
+    // PREPARE two locks, so that the threads alternate between them
+    TypeParam locks[2];
+    std::size_t counters[2] = {0, 0};
+    const int numberOfThreads = 8;
+    const int incrementsPerThread = 2000;
+
+    // WHEN
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&, i] {
+            for (int j = 0; j < incrementsPerThread; ++j) {
+                const auto k = (i + j) % 2;
+                std::lock_guard<TypeParam> guard(locks[k]);
+                ++counters[k];
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_EQ(numberOfThreads * incrementsPerThread,
+              counters[0] + counters[1]);
+}
+
+TYPED_TEST(QueueLockTest, ShouldBeReacquirableByTheSameThread)
+{
+    // PREPARE
+    TypeParam lock;
+
+    // WHEN
+    for (int i = 0; i < 3; ++i) {
+        lock.lock();
+        lock.unlock();
+    }
+
+    // THEN another thread isn't blocked
+    std::thread([&] {
+        lock.lock();
+        lock.unlock();
+    }).join();
+}
+
+TEST(SpinLockTest, TicketAndMCSLockTryLockShouldFailWhileLocked)
+{
+    // PREPARE
+    TicketLock ticketLock;
+    MCSLock mcsLock;
+
+    // WHEN
+    ticketLock.lock();
+    mcsLock.lock();
+
+    // THEN
+    std::thread([&] {
+        EXPECT_FALSE(ticketLock.try_lock());
+        EXPECT_FALSE(mcsLock.try_lock());
+    }).join();
+    ticketLock.unlock();
+    mcsLock.unlock();
+    EXPECT_TRUE(ticketLock.try_lock());
+    EXPECT_TRUE(mcsLock.try_lock());
+    ticketLock.unlock();
+    mcsLock.unlock();
+}
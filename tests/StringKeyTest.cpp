@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "LazySkipList.h"
+#include "LockFreeSkipList.h"
+#include "SequentialSkipList.h"
+#include "StringKey.h"
+
+TEST(StringKeyTest, ShouldOrderLikeStdString)
+{
+    // GIVEN strings sharing prefixes of different lengths
+    const std::vector<std::string> strings = {
+        "",          "a",        "ab",
+        "abc",       "abcdefg",  "abcdefgh",
+        "abcdefghi", "abcdefghj", "abcdefgi",
+        "b",         std::string("a\0b", 3), std::string("ab\0", 3),
+        "zzzzzzzzzzzzzzzz",      "zzzzzzzzzzzzzzzy"};
+
+    // THEN
+    for (const auto& lhs : strings) {
+        for (const auto& rhs : strings) {
+            EXPECT_EQ(lhs < rhs, StringKey(lhs) < StringKey(rhs))
+                << lhs << " < " << rhs;
+            EXPECT_EQ(lhs == rhs, StringKey(lhs) == StringKey(rhs))
+                << lhs << " == " << rhs;
+        }
+    }
+}
+
+template <typename List>
+class StringKeySkipListTest : public ::testing::Test
+{
+  protected:
+    List list;
+};
+
+using StringKeyImplementations = ::testing::Types<
+    SequentialSkipList<StringKey, 16>,
+    SequentialSkipList<StringKey, 16, SlabNodeAllocator<>>,
+    LazySkipList<StringKey, 16>, LockFreeSkipList<StringKey, 16>,
+    LockFreeSkipList<StringKey, 16, HazardPointerReclamation,
+                     SlabNodeAllocator<>>>;
+TYPED_TEST_CASE(StringKeySkipListTest, StringKeyImplementations);
+
+TYPED_TEST(StringKeySkipListTest, ShouldCopyKeysIntoList)
+{
+    // GIVEN keys with a common prefix, inserted from a reused buffer
+    const std::size_t numberOfKeys = 1000;
+    std::string buffer;
+    for (std::size_t i = 0; i < numberOfKeys; ++i) {
+        buffer = "common/prefix/" + std::to_string(i);
+        EXPECT_TRUE(this->list.insert(StringKey(buffer)));
+    }
+    buffer.assign(buffer.size(), 'x');
+
+    // THEN
+    EXPECT_EQ(numberOfKeys, this->list.size());
+    for (std::size_t i = 0; i < numberOfKeys; ++i) {
+        const std::string key = "common/prefix/" + std::to_string(i);
+        EXPECT_TRUE(this->list.contains(StringKey(key))) << key;
+        EXPECT_FALSE(this->list.insert(StringKey(key))) << key;
+    }
+    EXPECT_FALSE(this->list.contains(StringKey(std::string("common/prefix/"))));
+    EXPECT_FALSE(this->list.contains(StringKey(std::string("common"))));
+
+    // WHEN
+    for (std::size_t i = 0; i < numberOfKeys; i += 2) {
+        const std::string key = "common/prefix/" + std::to_string(i);
+        EXPECT_TRUE(this->list.remove(StringKey(key))) << key;
+    }
+
+    // THEN
+    EXPECT_EQ(numberOfKeys / 2, this->list.size());
+    for (std::size_t i = 0; i < numberOfKeys; ++i) {
+        const std::string key = "common/prefix/" + std::to_string(i);
+        EXPECT_EQ(i % 2 == 1, this->list.contains(StringKey(key))) << key;
+    }
+
+    this->list.clear();
+    EXPECT_TRUE(this->list.empty());
+}
+
+TYPED_TEST(StringKeySkipListTest, ShouldStoreEmptyKey)
+{
+    // WHEN
+    const bool inserted = this->list.insert(StringKey());
+
+    // THEN
+    EXPECT_TRUE(inserted);
+    EXPECT_TRUE(this->list.contains(StringKey("", 0)));
+    EXPECT_TRUE(this->list.remove(StringKey()));
+    EXPECT_TRUE(this->list.empty());
+}
+
+TYPED_TEST(StringKeySkipListTest, ShouldBulkLoadKeys)
+{
+    // GIVEN sorted keys which are longer than the prefix
+    std::vector<StringKey> keys;
+    std::vector<std::string> strings;
+    for (int i = 100000; i < 300000; ++i) {
+        strings.push_back("bulk/" + std::to_string(i));
+    }
+    for (const auto& string : strings) {
+        keys.push_back(StringKey(string));
+    }
+
+    // WHEN
+    const auto count =
+        this->list.bulkLoad(keys.data(), keys.data() + keys.size());
+    strings.clear();
+
+    // THEN the keys have been copied into the list
+    EXPECT_EQ(200000, count);
+    EXPECT_TRUE(this->list.contains(StringKey(std::string("bulk/100000"))));
+    EXPECT_TRUE(this->list.contains(StringKey(std::string("bulk/299999"))));
+    EXPECT_FALSE(this->list.contains(StringKey(std::string("bulk/300000"))));
+    EXPECT_TRUE(this->list.remove(StringKey(std::string("bulk/200000"))));
+    EXPECT_EQ(199999, this->list.size());
+}
+
+template <typename List>
+class ComparatorSkipListTest : public ::testing::Test
+{
+  protected:
+    List list;
+};
+
+using ComparatorImplementations = ::testing::Types<
+    SequentialSkipList<int, 16, HeapNodeAllocator, HalfHeightGenerator,
+                       std::greater<int>>,
+    LazySkipList<int, 16, HeapNodeAllocator, HalfHeightGenerator,
+                 std::greater<int>>,
+    LockFreeSkipList<int, 16, EpochBasedReclamation, HeapNodeAllocator,
+                     HalfHeightGenerator, std::greater<int>>>;
+TYPED_TEST_CASE(ComparatorSkipListTest, ComparatorImplementations);
+
+TYPED_TEST(ComparatorSkipListTest, ShouldStoreExtremeValues)
+{
+    // GIVEN values which were reserved for head and sentinel before
+    const std::vector<int> values = {std::numeric_limits<int>::min(), -1, 0, 1,
+                                     std::numeric_limits<int>::max()};
+
+    // WHEN
+    for (auto value : values) {
+        EXPECT_TRUE(this->list.insert(value));
+    }
+
+    // THEN
+    EXPECT_EQ(values.size(), this->list.size());
+    for (auto value : values) {
+        EXPECT_TRUE(this->list.contains(value));
+        EXPECT_TRUE(this->list.remove(value));
+        EXPECT_FALSE(this->list.contains(value));
+    }
+    EXPECT_TRUE(this->list.empty());
+}
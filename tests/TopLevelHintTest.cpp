@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "LazySkipList.h"
+#include "LockFreeSkipList.h"
+
+template <typename List>
+class TopLevelHintTest : public ::testing::Test
+{
+  protected:
+    // more levels than any test fills
+    List list;
+};
+
+using TopLevelHintImplementations =
+    ::testing::Types<LazySkipList<int, 64>, LockFreeSkipList<int, 64>,
+                     LockFreeSkipList<int, 64, HazardPointerReclamation>>;
+TYPED_TEST_CASE(TopLevelHintTest, TopLevelHintImplementations);
+
+TYPED_TEST(TopLevelHintTest, SearchesShouldStartAtTheHighestLevelInUse)
+{
+    // PREPARE
+    EXPECT_EQ(0, this->list.topLevel());
+    const int numberOfValues = 1 << 14;
+
+    // WHEN
+    for (int i = 0; i < numberOfValues; ++i) {
+        this->list.insert(i);
+    }
+
+    // THEN the searches start where a list of this size needs them to, far
+    // below the top level of the head
+    const auto topLevel = this->list.topLevel();
+    EXPECT_LE(5, topLevel);
+    EXPECT_GT(40, topLevel);
+
+    // WHEN
+    for (int i = 0; i < numberOfValues; ++i) {
+        this->list.remove(i);
+    }
+
+    // THEN the hint only grows, the empty levels are still searched correctly
+    EXPECT_EQ(topLevel, this->list.topLevel());
+    EXPECT_TRUE(this->list.empty());
+    EXPECT_FALSE(this->list.contains(0));
+    EXPECT_TRUE(this->list.insert(0));
+    EXPECT_TRUE(this->list.contains(0));
+}
+
+TYPED_TEST(TopLevelHintTest, SearchesShouldFindValuesWhileTheTopLevelGrows)
+{
+    // PREPARE an empty list, the hint grows with the first inserts
+    const int numberOfThreads = 4;
+    const int elementsPerThread = 2000;
+    std::vector<std::atomic<int>> inserted(numberOfThreads);
+    for (auto& value : inserted) {
+        value.store(-1);
+    }
+
+    // WHEN the threads insert while another one looks up their last values
+    std::vector<std::thread> writers;
+    for (int i = 0; i < numberOfThreads; i++) {
+        writers.emplace_back([&, i] {
+            for (int j = i; j < numberOfThreads * elementsPerThread;
+                 j += numberOfThreads) {
+                EXPECT_TRUE(this->list.insert(j));
+                EXPECT_TRUE(this->list.contains(j));
+                inserted[i].store(j, std::memory_order_release);
+            }
+        });
+    }
+    std::atomic<bool> done(false);
+    std::thread reader([&] {
+        std::uint16_t previous = 0;
+        while (!done.load()) {
+            const auto topLevel = this->list.topLevel();
+            EXPECT_LE(previous, topLevel);
+            previous = topLevel;
+            for (auto& value : inserted) {
+                const int last = value.load(std::memory_order_acquire);
+                if (last >= 0) {
+                    EXPECT_TRUE(this->list.contains(last)) << last;
+                }
+            }
+        }
+    });
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done.store(true);
+    reader.join();
+
+    // THEN
+    EXPECT_EQ(numberOfThreads * elementsPerThread, this->list.size());
+    for (int i = 0; i < numberOfThreads * elementsPerThread; ++i) {
+        EXPECT_TRUE(this->list.contains(i)) << i;
+    }
+    EXPECT_LE(4, this->list.topLevel());
+}
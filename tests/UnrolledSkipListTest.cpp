@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "BlockSearch.h"
+#include "UnrolledSkipList.h"
+
+class UnrolledSkipListTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        // small blocks, so that the tests below split and merge a lot
+        list = std::make_unique<UnrolledSkipList<int, 16, 8>>();
+    }
+
+    std::unique_ptr<SkipList<int>> list;
+};
+
+TEST_F(UnrolledSkipListTest,
+       InsertingAndRemovingMultipleElementsInParallelShouldWork)
+{
+    // WHEN the threads split and merge the blocks of each other
+    const int numberOfThreads = 8;
+    const int elementsPerThread = 2000;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i++) {
+        threads.emplace_back([&, i] {
+            for (int j = i; j < numberOfThreads * elementsPerThread;
+                 j += numberOfThreads) {
+                EXPECT_TRUE(list->insert(j));
+                EXPECT_TRUE(list->contains(j));
+            }
+            for (int j = i; j < numberOfThreads * elementsPerThread;
+                 j += numberOfThreads) {
+                EXPECT_TRUE(list->remove(j));
+                EXPECT_FALSE(list->contains(j));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // THEN
+    EXPECT_TRUE(list->empty());
+}
+
+TEST_F(UnrolledSkipListTest, LookupsShouldSeeValuesWhileBlocksChange)
+{
+    // PREPARE values which are never removed
+    const int numberOfValues = 4000;
+    for (int value = 0; value < numberOfValues; value += 2) {
+        list->insert(value);
+    }
+
+    // WHEN the odd values are inserted and removed meanwhile
+    std::atomic<bool> done(false);
+    std::vector<std::thread> writers;
+    for (int i = 0; i < 4; i++) {
+        writers.emplace_back([&, i] {
+            for (int round = 0; round < 3; ++round) {
+                for (int j = 2 * i + 1; j < numberOfValues; j += 8) {
+                    EXPECT_TRUE(list->insert(j));
+                }
+                for (int j = 2 * i + 1; j < numberOfValues; j += 8) {
+                    EXPECT_TRUE(list->remove(j));
+                }
+            }
+        });
+    }
+    std::thread reader([&] {
+        while (!done) {
+            for (int value = 0; value < numberOfValues; value += 2) {
+                EXPECT_TRUE(list->contains(value));
+            }
+            int expected = 0;
+            list->rangeScan(0, numberOfValues, [&](int value) {
+                if (value % 2 == 0) {
+                    EXPECT_EQ(expected, value);
+                    expected = value + 2;
+                }
+            });
+            EXPECT_EQ(numberOfValues, expected);
+        }
+    });
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+
+    // THEN
+    EXPECT_EQ(numberOfValues / 2, list->size());
+}
+
+TEST(UnrolledSkipListBlockTest, BlocksShouldBeSplitAndMerged)
+{
+    // PREPARE
+    UnrolledSkipList<long, 16, 8> list;
+    const long numberOfValues = 1000;
+
+    // WHEN
+    for (long value = 0; value < numberOfValues; ++value) {
+        list.insert(value);
+    }
+
+    // THEN ascending inserts split off half full blocks
+    EXPECT_GE(list.numberOfBlocks(), numberOfValues / 8);
+    EXPECT_LE(list.numberOfBlocks(), numberOfValues / 4);
+
+    // WHEN
+    for (long value = 0; value < numberOfValues; ++value) {
+        if (value % 100 != 0) {
+            EXPECT_TRUE(list.remove(value));
+        }
+    }
+
+    // THEN the blocks of the remaining values have been merged
+    EXPECT_LE(list.numberOfBlocks(), 10u);
+    std::vector<long> visited;
+    list.rangeScan(0, numberOfValues,
+                   [&](long value) { visited.push_back(value); });
+    EXPECT_EQ((std::vector<long>{0, 100, 200, 300, 400, 500, 600, 700, 800,
+                                 900}),
+              visited);
+
+    // WHEN
+    list.clear();
+
+    // THEN
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(0u, list.numberOfBlocks());
+}
+
+template <typename T>
+class BlockSearchTest : public ::testing::Test
+{
+};
+
+using SearchedTypes = ::testing::Types<std::int32_t, std::int64_t, double>;
+TYPED_TEST_CASE(BlockSearchTest, SearchedTypes);
+
+TYPED_TEST(BlockSearchTest, RankShouldMatchLowerBound)
+{
+    // PREPARE blocks of every length up to three vectors plus a remainder
+    std::vector<TypeParam> keys;
+    for (int i = 0; i < 27; ++i) {
+        keys.push_back(static_cast<TypeParam>(3 * i - 20));
+    }
+
+    for (std::size_t count = 0; count <= keys.size(); ++count) {
+        for (int value = -25; value < 65; ++value) {
+            // WHEN
+            const auto rank =
+                BlockSearch<TypeParam, std::less<TypeParam>>::rank(
+                    keys.data(), count, static_cast<TypeParam>(value),
+                    std::less<TypeParam>());
+
+            // THEN
+            const auto expected =
+                std::lower_bound(keys.data(), keys.data() + count,
+                                 static_cast<TypeParam>(value)) -
+                keys.data();
+            EXPECT_EQ(static_cast<std::size_t>(expected), rank);
+        }
+    }
+}
+
+#define ABSTRACT_SKIP_LIST_TEST_IMPL UnrolledSkipListTest
+#include "AbstractSkipListTest.h"